@@ -0,0 +1,296 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_ALTSEARCH_H
+#define MJA_ALTSEARCH_H
+
+#include "mja_GraphCSR.h"
+#include "mja_DaryHeap.h"
+#include "mja_dijkstra.h" //landmark distance tables are built with full dijkstra runs
+#include <limits>
+
+//point to point shortest paths using bidirectional A* with ALT (A*, landmarks and the triangle inequality) lower bounds
+//preprocessing runs dijkstra to and from a few landmark vertices, then by the triangle inequality
+//d(v,t) >= d(L,t) - d(L,v) and d(v,t) >= d(v,L) - d(t,L) for every landmark L, which steers each query towards its target
+//memory is 2 distances per landmark per vertex, stored per vertex so one vertex's bounds share a cache line
+//the graph must outlive the search object and must not have negative weights
+class mja_ALTSearch {
+
+private:
+
+    mja_GraphCSR* graph;
+    mja_GraphCSR* reverse; //transpose of the graph, used by the backward search and to find distances to each landmark
+    int n;
+    int landmarkCount;
+    int* landmarks;
+    double* fromLandmark; //fromLandmark[v * landmarkCount + l] is d(landmark l, v)
+    double* toLandmark; //toLandmark[v * landmarkCount + l] is d(v, landmark l)
+
+    //per query state, only the touched vertices are reset between queries so a query costs what it explores
+    double* distF;
+    double* distR;
+    int* predF; //previous vertex on the path from the source
+    int* predR; //next vertex on the path to the target
+    int* touched;
+    int touchedCount = 0;
+    mja_DaryHeap<double, 4>* heapF;
+    mja_DaryHeap<double, 4>* heapR;
+    int lastSource = -1;
+    int lastTarget = -1;
+    int lastMeet = -1; //vertex where the best path's two halves meet, -1 if the target wasn't reached
+    int lastSettled = 0;
+
+    double lowerBound(int v, int w); //landmark lower bound on d(v, w)
+    double potential(int v){return (lowerBound(v, lastTarget) - lowerBound(lastSource, v)) / 2.0;}; //forward search's potential, the backward search uses its negative
+    void pickLandmarks(); //farthest point selection, each landmark is the vertex furthest from all of the landmarks chosen so far
+    void touch(int v){if (distF[v] == std::numeric_limits<double>::infinity() && distR[v] == std::numeric_limits<double>::infinity()){touched[touchedCount++] = v;}};
+
+public:
+
+    mja_ALTSearch(mja_GraphCSR &graph, int landmarkCount);
+    mja_ALTSearch(mja_ALTSearch &oldSearch) = delete; //preprocessing is costly, share one search object instead
+
+    ~mja_ALTSearch(){
+        delete reverse;
+        delete[] landmarks;
+        delete[] fromLandmark;
+        delete[] toLandmark;
+        delete[] distF;
+        delete[] distR;
+        delete[] predF;
+        delete[] predR;
+        delete[] touched;
+        delete heapF;
+        delete heapR;
+    };
+
+    int getLandmarkCount(){return landmarkCount;};
+    const int* getLandmarks(){return landmarks;};
+
+    double query(int source, int target); //shortest distance between two dense vertex indices, infinity if target can't be reached
+    int getLastSettled(){return lastSettled;}; //vertices settled by the last query, across both directions
+    int* getLastPath(int &length); //path of the last query as dense indices from source to target (caller must delete[]), nullptr if there wasn't one
+};
+
+/*
+more lengthy/looping functions are defined below to prevent above main header getting spammed
+*/
+
+//base constructor, picks the landmarks and builds their distance tables
+inline mja_ALTSearch :: mja_ALTSearch(mja_GraphCSR &graph, int landmarkCount){
+    this->graph = &graph;
+    this->reverse = graph.transpose();
+    this->n = graph.getVertexCount();
+    if (landmarkCount > n){
+        landmarkCount = n;
+    }
+    this->landmarkCount = (landmarkCount > 0) ? landmarkCount : 0;
+    landmarks = new int[this->landmarkCount];
+    fromLandmark = new double[(long long)n * this->landmarkCount];
+    toLandmark = new double[(long long)n * this->landmarkCount];
+    distF = new double[n];
+    distR = new double[n];
+    predF = new int[n];
+    predR = new int[n];
+    touched = new int[n];
+    for (int i=0; i<n; i++){
+        distF[i] = std::numeric_limits<double>::infinity();
+        distR[i] = std::numeric_limits<double>::infinity();
+    }
+    heapF = new mja_DaryHeap<double, 4>(n);
+    heapR = new mja_DaryHeap<double, 4>(n);
+    pickLandmarks();
+};
+
+//each landmark after the first is the vertex whose closest landmark (by forward distance) is furthest away,
+//landmarks on the edge of the graph give the tightest bounds for queries that cross it
+inline void mja_ALTSearch :: pickLandmarks(){
+    const double INF = std::numeric_limits<double>::infinity();
+    double* dist = new double[n];
+    int* pred = new int[n];
+    double* closest = new double[n]; //distance from each vertex's nearest landmark so far
+    for (int v=0; v<n; v++){
+        closest[v] = INF;
+    }
+    //start from the vertex furthest from vertex 0
+    int next = 0;
+    if (n > 0){
+        mja_dijkstra(*graph, 0, dist, pred);
+        for (int v=0; v<n; v++){
+            if (dist[v] != INF && dist[v] > dist[next]){
+                next = v;
+            }
+        }
+    }
+    for (int l=0; l<landmarkCount; l++){
+        landmarks[l] = next;
+        mja_dijkstra(*graph, next, dist, pred);
+        for (int v=0; v<n; v++){
+            fromLandmark[(long long)v * landmarkCount + l] = dist[v];
+            if (dist[v] < closest[v]){
+                closest[v] = dist[v];
+            }
+        }
+        mja_dijkstra(*reverse, next, dist, pred); //distances in the transpose are distances to the landmark
+        for (int v=0; v<n; v++){
+            toLandmark[(long long)v * landmarkCount + l] = dist[v];
+        }
+        //unreachable vertices count as furthest away, so a landmark ends up in each part of the graph the others can't reach
+        double best = -1.0;
+        for (int v=0; v<n; v++){
+            if (closest[v] > best){
+                best = closest[v];
+                next = v;
+            }
+        }
+    }
+    delete[] dist;
+    delete[] pred;
+    delete[] closest;
+};
+
+//best lower bound on d(v, w) over all of the landmarks, terms with an unreachable side are skipped
+//a skipped term can only make the bound inconsistent on edges into vertices that can't be on a path to w, so queries stay exact
+inline double mja_ALTSearch :: lowerBound(int v, int w){
+    const double INF = std::numeric_limits<double>::infinity();
+    const double* fromV = &(fromLandmark[(long long)v * landmarkCount]);
+    const double* fromW = &(fromLandmark[(long long)w * landmarkCount]);
+    const double* toV = &(toLandmark[(long long)v * landmarkCount]);
+    const double* toW = &(toLandmark[(long long)w * landmarkCount]);
+    double output = 0.0;
+    for (int l=0; l<landmarkCount; l++){
+        if (fromV[l] != INF && fromW[l] != INF && fromW[l] - fromV[l] > output){
+            output = fromW[l] - fromV[l]; //d(L,w) <= d(L,v) + d(v,w)
+        }
+        if (toV[l] != INF && toW[l] != INF && toV[l] - toW[l] > output){
+            output = toV[l] - toW[l]; //d(v,L) <= d(v,w) + d(w,L)
+        }
+    }
+    return output;
+};
+
+//bidirectional A* with the average potential p(v) = (bound(v,t) - bound(s,v)) / 2, both searches then see the same non-negative reduced edge lengths
+//so it's a plain bidirectional dijkstra on the reduced graph, stopping once the two smallest keys sum to at least the best path found
+inline double mja_ALTSearch :: query(int source, int target){
+    const double INF = std::numeric_limits<double>::infinity();
+    for (int i=0; i<touchedCount; i++){
+        distF[touched[i]] = INF;
+        distR[touched[i]] = INF;
+    }
+    touchedCount = 0;
+    heapF->clear();
+    heapR->clear();
+    lastSource = source;
+    lastTarget = target;
+    lastMeet = -1;
+    lastSettled = 0;
+    if (source < 0 || source >= n || target < 0 || target >= n){
+        return INF;
+    }
+
+    const long long* offsetsF = graph->getOffsets();
+    const int* targetsF = graph->getTargets();
+    const double* weightsF = graph->getWeights();
+    const long long* offsetsR = reverse->getOffsets();
+    const int* targetsR = reverse->getTargets();
+    const double* weightsR = reverse->getWeights();
+
+    touch(source);
+    distF[source] = 0.0;
+    predF[source] = -1;
+    touch(target);
+    distR[target] = 0.0;
+    predR[target] = -1;
+    double best = (source == target) ? 0.0 : INF;
+    if (source == target){
+        lastMeet = source;
+    }
+    heapF->push(source, potential(source));
+    heapR->push(target, -potential(target));
+
+    while (!heapF->isEmpty() && !heapR->isEmpty()){
+        if (heapF->getTopPriority() + heapR->getTopPriority() >= best){
+            break; //no path through an unsettled vertex can beat the best one found
+        }
+        bool forward = (heapF->getTopPriority() <= heapR->getTopPriority());
+        mja_DaryHeap<double, 4>* heap = forward ? heapF : heapR;
+        double* dist = forward ? distF : distR;
+        double* otherDist = forward ? distR : distF;
+        int* pred = forward ? predF : predR;
+        const long long* offsets = forward ? offsetsF : offsetsR;
+        const int* targets = forward ? targetsF : targetsR;
+        const double* weights = forward ? weightsF : weightsR;
+
+        int u = heap->pop();
+        lastSettled++;
+        for (long long e=offsets[u]; e<offsets[u+1]; e++){
+            int v = targets[e];
+            double d = dist[u] + weights[e];
+            if (d < dist[v]){
+                touch(v);
+                dist[v] = d;
+                pred[v] = u;
+                double pot = potential(v);
+                //vertices can be reopened, which keeps results exact even if rounding makes a reduced length slightly negative
+                heap->pushOrDecrease(v, forward ? d + pot : d - pot);
+                if (otherDist[v] != INF && d + otherDist[v] < best){
+                    best = d + otherDist[v];
+                    lastMeet = v;
+                }
+            }
+        }
+    }
+    return best;
+};
+
+//joins the forward half (source to meet) and the backward half (meet to target) of the last query's path
+inline int* mja_ALTSearch :: getLastPath(int &length){
+    length = 0;
+    if (lastMeet < 0){
+        return nullptr; //last query didn't reach its target
+    }
+    int forwardLength = 0;
+    for (int v = lastMeet; v != -1; v = predF[v]){
+        forwardLength++;
+    }
+    length = forwardLength;
+    for (int v = predR[lastMeet]; v != -1; v = predR[v]){
+        length++;
+    }
+    int* output = new int[length];
+    int i = forwardLength;
+    for (int v = lastMeet; v != -1; v = predF[v]){
+        output[--i] = v; //pre decrement access, fills the forward half from the meeting point back
+    }
+    i = forwardLength;
+    for (int v = predR[lastMeet]; v != -1; v = predR[v]){
+        output[i++] = v; //post increment access
+    }
+    return output;
+};
+
+
+#endif
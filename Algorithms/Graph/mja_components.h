@@ -0,0 +1,161 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_COMPONENTS_H
+#define MJA_COMPONENTS_H
+
+#include "mja_GraphCSR.h"
+#include "mja_UnionFind.h"
+#include "mja_graphParallel.h"
+
+//connected components of a frozen graph, both label every vertex in a flat array indexed by dense vertex index
+
+//weakly connected components (edge direction ignored), labels[v] is the smallest vertex index in v's component
+//threads take edge balanced row ranges and unite every edge's ends in a shared lock free union find, then every vertex looks up its root
+//labels must have room for graph.getVertexCount() values, threadCount of 0 uses every hardware thread, returns the number of components
+inline int mja_weakComponents(mja_GraphCSR &graph, int* labels, int threadCount){
+    int n = graph.getVertexCount();
+    if (n == 0){
+        return 0;
+    }
+    const long long* offsets = graph.getOffsets();
+    const int* targets = graph.getTargets();
+    threadCount = mja_resolveThreadCount(threadCount);
+    if (threadCount > n){
+        threadCount = n;
+    }
+    mja_ConcurrentUnionFind sets(n);
+    int* bounds = new int[threadCount + 1];
+    mja_edgeBalancedSplit(offsets, n, threadCount, bounds);
+
+    auto unitePart = [&](int p){
+        for (int u=bounds[p]; u<bounds[p+1]; u++){
+            for (long long e=offsets[u]; e<offsets[u+1]; e++){
+                if (targets[e] != u){
+                    sets.unite(u, targets[e]);
+                }
+            }
+        }
+    };
+    mja_runParts(threadCount, unitePart);
+
+    //every union has finished, so each root is its set's smallest index
+    std::atomic<int> count(0);
+    auto labelPart = [&](int p){
+        int local = 0;
+        for (int v=bounds[p]; v<bounds[p+1]; v++){
+            labels[v] = sets.find(v);
+            if (labels[v] == v){
+                local++;
+            }
+        }
+        count.fetch_add(local, std::memory_order_relaxed);
+    };
+    mja_runParts(threadCount, labelPart);
+    delete[] bounds;
+    return count.load();
+}
+
+//single threaded weak components
+inline int mja_weakComponents(mja_GraphCSR &graph, int* labels){
+    return mja_weakComponents(graph, labels, 1);
+}
+
+//strongly connected components by Tarjan's algorithm, with the recursion replaced by an explicit stack of (vertex, next edge) so deep graphs can't overflow the call stack
+//labels[v] runs from 0 to count-1, components are numbered in the order they complete, which is a reverse topological order of the condensation
+//(an edge between two components always goes from the higher label to the lower one)
+//labels must have room for graph.getVertexCount() values, returns the number of components
+inline int mja_strongComponents(mja_GraphCSR &graph, int* labels){
+    int n = graph.getVertexCount();
+    const long long* offsets = graph.getOffsets();
+    const int* targets = graph.getTargets();
+    int* order = new int[n]; //discovery order of each vertex, -1 if not yet visited
+    int* low = new int[n]; //smallest discovery order reachable through the vertex's subtree and one back edge
+    int* stack = new int[n]; //visited vertices that don't have a component yet
+    int* callVertex = new int[n]; //explicit recursion, the vertex and the next edge to look at for every level
+    long long* callEdge = new long long[n];
+    for (int i=0; i<n; i++){
+        order[i] = -1;
+        labels[i] = -1; //-1 also marks vertices still on the stack, so no separate on stack flags are needed
+    }
+    int visited = 0;
+    int stackSize = 0;
+    int count = 0;
+
+    for (int root=0; root<n; root++){
+        if (order[root] != -1){
+            continue;
+        }
+        int depth = 0;
+        callVertex[0] = root;
+        callEdge[0] = offsets[root];
+        order[root] = low[root] = visited++;
+        stack[stackSize++] = root;
+        while (depth >= 0){
+            int u = callVertex[depth];
+            long long e = callEdge[depth];
+            if (e < offsets[u+1]){
+                callEdge[depth] = e + 1;
+                int v = targets[e];
+                if (order[v] == -1){ //tree edge, recurse into v
+                    order[v] = low[v] = visited++;
+                    stack[stackSize++] = v;
+                    depth++;
+                    callVertex[depth] = v;
+                    callEdge[depth] = offsets[v];
+                } else if (labels[v] == -1 && order[v] < low[u]){ //v is still on the stack
+                    low[u] = order[v];
+                }
+                continue;
+            }
+            //every edge of u is done, pop u's component off if u is its root
+            if (low[u] == order[u]){
+                int w;
+                do {
+                    w = stack[--stackSize]; //pre decrement access
+                    labels[w] = count;
+                } while (w != u);
+                count++;
+            }
+            depth--;
+            if (depth >= 0){ //return to the parent
+                int parent = callVertex[depth];
+                if (low[u] < low[parent]){
+                    low[parent] = low[u];
+                }
+            }
+        }
+    }
+    delete[] order;
+    delete[] low;
+    delete[] stack;
+    delete[] callVertex;
+    delete[] callEdge;
+    return count;
+}
+
+
+#endif
@@ -0,0 +1,159 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_DIJKSTRA_H
+#define MJA_DIJKSTRA_H
+
+#include "mja_GraphCSR.h"
+#include "mja_DaryHeap.h"
+#include "mja_RadixHeap.h"
+#include <limits> //needed for infinity, the distance of unreachable vertices
+#include <cmath> //needed for floor, checking weights are whole numbers
+
+//true if every weight is a whole number from 0 to 2^53, so it and any path length stay exact once converted to a radix heap key
+inline bool mja_dijkstraIntegerWeights(mja_GraphCSR &graph){
+    long long m = graph.getEdgeCount();
+    const double* weights = graph.getWeights();
+    for (long long e=0; e<m; e++){
+        double w = weights[e];
+        if (!(w >= 0.0 && w <= 9007199254740992.0 && w == std::floor(w))){ //negated so NaN fails too
+            return false;
+        }
+    }
+    return true;
+}
+
+//configuration codes for dijkstra, picks the priority queue
+class mja_ConfigCode_Dijkstra {
+
+public:
+
+    static const int HEAP_DARY = 0; //4-ary heap with decrease key, works with any non-negative weights
+    static const int HEAP_RADIX = 1; //radix heap, only for graphs whose weights are all non-negative integers, falls back to HEAP_DARY otherwise
+};
+
+//single source shortest paths over a frozen graph (see mja_GraphAdjList::freeze), vertices are dense indices
+//dist and pred must each have room for graph.getVertexCount() values, so repeated queries can reuse them
+//dist[v] is the shortest distance to v (infinity if unreachable) and pred[v] is the vertex before v on that path (-1 for the source and unreachable vertices)
+//if target isn't -1 the search stops once target is settled, only vertices settled by then are final
+//returns the number of vertices settled, weights must be non-negative
+inline int mja_dijkstra(mja_GraphCSR &graph, int source, int target, double* dist, int* pred, int heapType){
+    int n = graph.getVertexCount();
+    const long long* offsets = graph.getOffsets();
+    const int* targets = graph.getTargets();
+    const double* weights = graph.getWeights();
+    for (int i=0; i<n; i++){
+        dist[i] = std::numeric_limits<double>::infinity();
+        pred[i] = -1;
+    }
+    if (source < 0 || source >= n){
+        return 0; //nothing reachable from a vertex that doesn't exist
+    }
+    dist[source] = 0.0;
+    int settled = 0;
+
+    if (heapType == mja_ConfigCode_Dijkstra::HEAP_RADIX && mja_dijkstraIntegerWeights(graph)){ //fractional keys would be truncated and then skipped as stale
+        //lazy deletion, a vertex is pushed again whenever its distance drops and stale copies are skipped when popped
+        mja_RadixHeap<int> heap;
+        bool* done = new bool[n];
+        for (int i=0; i<n; i++){
+            done[i] = false;
+        }
+        heap.push(0, source);
+        while (!heap.isEmpty()){
+            unsigned long long key = heap.getTopKey();
+            int u = heap.pop();
+            if (done[u] || (double)key != dist[u]){
+                continue; //stale copy
+            }
+            done[u] = true;
+            settled++;
+            if (u == target){
+                break;
+            }
+            for (long long e=offsets[u]; e<offsets[u+1]; e++){
+                int v = targets[e];
+                double d = dist[u] + weights[e];
+                if (d < dist[v]){
+                    dist[v] = d;
+                    pred[v] = u;
+                    heap.push((unsigned long long)d, v);
+                }
+            }
+        }
+        delete[] done;
+    } else {
+        mja_DaryHeap<double, 4> heap(n);
+        heap.push(source, 0.0);
+        while (!heap.isEmpty()){
+            int u = heap.pop();
+            settled++;
+            if (u == target){
+                break;
+            }
+            double du = dist[u];
+            for (long long e=offsets[u]; e<offsets[u+1]; e++){
+                int v = targets[e];
+                double d = du + weights[e];
+                if (d < dist[v]){
+                    dist[v] = d;
+                    pred[v] = u;
+                    heap.pushOrDecrease(v, d);
+                }
+            }
+        }
+    }
+    return settled;
+}
+
+//shortest paths from source to every vertex using the 4-ary heap
+inline int mja_dijkstra(mja_GraphCSR &graph, int source, double* dist, int* pred){
+    return mja_dijkstra(graph, source, -1, dist, pred, mja_ConfigCode_Dijkstra::HEAP_DARY);
+}
+
+//walks pred back from target, returns the path from source to target as dense indices (caller must delete[]) or nullptr if target wasn't reached
+inline int* mja_dijkstraPath(const int* pred, int source, int target, int &length){
+    length = 0;
+    for (int v = target; v != -1; v = pred[v]){
+        length++;
+        if (v == source){
+            break;
+        }
+    }
+    if (length == 0 || (target != source && pred[target] == -1)){
+        length = 0;
+        return nullptr; //target wasn't reached
+    }
+    int* output = new int[length];
+    int i = length;
+    for (int v = target; i > 0; v = pred[v]){
+        output[--i] = v; //pre decrement access, fills from the back
+    }
+    return output;
+}
+
+
+#endif
@@ -0,0 +1,104 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_GRAPHPARALLEL_H
+#define MJA_GRAPHPARALLEL_H
+
+#include <thread>
+#include <atomic>
+
+//threading helpers shared by the parallel graph algorithms, each call starts its own threads and joins them before returning
+
+//turns a requested thread count into a usable one, 0 (or less) means every hardware thread
+inline int mja_resolveThreadCount(int threadCount){
+    if (threadCount <= 0){
+        threadCount = (int)std::thread::hardware_concurrency();
+    }
+    return (threadCount > 0) ? threadCount : 1;
+}
+
+//runs call(begin, end, thread) over [0, count) in chunks of grain, threads take the next chunk from a shared counter so uneven chunks balance out
+template <typename Tcall>
+void mja_parallelChunks(int count, int grain, int threadCount, Tcall &call){
+    std::atomic<int> nextChunk(0);
+    auto worker = [&](int t){
+        while (true){
+            int begin = nextChunk.fetch_add(grain, std::memory_order_relaxed);
+            if (begin >= count){
+                break;
+            }
+            call(begin, (begin + grain < count) ? begin + grain : count, t);
+        }
+    };
+    std::thread* threads = new std::thread[threadCount];
+    for (int t=1; t<threadCount; t++){
+        threads[t] = std::thread(worker, t);
+    }
+    worker(0);
+    for (int t=1; t<threadCount; t++){
+        threads[t].join();
+    }
+    delete[] threads;
+}
+
+//splits the rows of a csr into parts with roughly equal work, bounds gets parts + 1 row indices (part p is rows bounds[p] to bounds[p+1]-1)
+//a row's work is its edges plus one for the row itself, offsets[v] + v is then the work before row v so each split is a binary search
+inline void mja_edgeBalancedSplit(const long long* offsets, int n, int parts, int* bounds){
+    long long work = offsets[n] + n;
+    bounds[0] = 0;
+    for (int p=1; p<parts; p++){
+        long long goal = work * p / parts;
+        int left = bounds[p-1];
+        int right = n;
+        while (left < right){
+            int mid = left + (right - left)/2;
+            if (offsets[mid] + mid < goal){
+                left = mid + 1;
+            } else {
+                right = mid;
+            }
+        }
+        bounds[p] = left;
+    }
+    bounds[parts] = n;
+}
+
+//runs call(part) for every part on its own thread, the calling thread takes part 0
+template <typename Tcall>
+void mja_runParts(int parts, Tcall &call){
+    std::thread* threads = new std::thread[parts];
+    for (int p=1; p<parts; p++){
+        threads[p] = std::thread(call, p);
+    }
+    call(0);
+    for (int p=1; p<parts; p++){
+        threads[p].join();
+    }
+    delete[] threads;
+}
+
+
+#endif
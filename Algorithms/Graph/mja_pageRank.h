@@ -0,0 +1,188 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_PAGERANK_H
+#define MJA_PAGERANK_H
+
+#include "mja_GraphCSR.h"
+#include "mja_graphParallel.h"
+
+//pull based sparse matrix vector kernels over frozen graphs
+//each vertex reads its in neighbours and writes only its own result, so threads never write to the same place and no atomics are needed
+//threads get contiguous vertex ranges holding roughly equal numbers of edges, so a few hub vertices can't leave one thread with most of the work
+
+//sums of gathered values use 4 independent accumulators, breaking the dependency between additions so they pipeline (and vectorise where gathers are available)
+inline double mja_gatherSum(const int* index, const double* values, long long begin, long long end){
+    double sum0 = 0.0;
+    double sum1 = 0.0;
+    double sum2 = 0.0;
+    double sum3 = 0.0;
+    long long e = begin;
+    for (; e + 4 <= end; e += 4){
+        sum0 += values[index[e]];
+        sum1 += values[index[e+1]];
+        sum2 += values[index[e+2]];
+        sum3 += values[index[e+3]];
+    }
+    for (; e < end; e++){
+        sum0 += values[index[e]];
+    }
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+//y = A x where row v of A is vertex v's edges in graph (pass the transpose to multiply by the adjacency matrix's transpose instead)
+//y[v] is the sum over v's edges e of weights[e] * x[targets[e]], threadCount of 0 uses every hardware thread
+inline void mja_spmv(mja_GraphCSR &graph, const double* x, double* y, int threadCount){
+    int n = graph.getVertexCount();
+    const long long* offsets = graph.getOffsets();
+    const int* targets = graph.getTargets();
+    const double* weights = graph.getWeights();
+    threadCount = mja_resolveThreadCount(threadCount);
+    int* bounds = new int[threadCount + 1];
+    mja_edgeBalancedSplit(offsets, n, threadCount, bounds);
+    auto call = [&](int p){
+        for (int v=bounds[p]; v<bounds[p+1]; v++){
+            double sum0 = 0.0;
+            double sum1 = 0.0;
+            long long e = offsets[v];
+            for (; e + 2 <= offsets[v+1]; e += 2){
+                sum0 += weights[e] * x[targets[e]];
+                sum1 += weights[e+1] * x[targets[e+1]];
+            }
+            if (e < offsets[v+1]){
+                sum0 += weights[e] * x[targets[e]];
+            }
+            y[v] = sum0 + sum1;
+        }
+    };
+    mja_runParts(threadCount, call);
+    delete[] bounds;
+}
+
+//pagerank by pull based power iteration, reverse is graph's transpose (built and freed internally if nullptr)
+//ranks must have room for graph.getVertexCount() values and comes back summing to 1, rank from vertices without out edges is spread over every vertex
+//stops once the L1 change in an iteration drops below tolerance or after maxIterations, returns the number of iterations run
+inline int mja_pageRank(mja_GraphCSR &graph, mja_GraphCSR* reverse, double* ranks, double damping, double tolerance, int maxIterations, int threadCount){
+    int n = graph.getVertexCount();
+    if (n == 0){
+        return 0;
+    }
+    threadCount = mja_resolveThreadCount(threadCount);
+    bool ownReverse = (reverse == nullptr);
+    if (ownReverse){
+        reverse = graph.transpose();
+    }
+    const long long* outOffsets = graph.getOffsets();
+    const long long* inOffsets = reverse->getOffsets();
+    const int* inTargets = reverse->getTargets();
+
+    //contribution of each vertex to each of its out neighbours, rank / out degree, double buffered with the ranks
+    double* invDegree = new double[n];
+    double* contrib = new double[n];
+    double* nextContrib = new double[n];
+    double* nextRanks = new double[n];
+    double* danglingParts = new double[threadCount];
+    double* diffParts = new double[threadCount];
+    int* bounds = new int[threadCount + 1];
+    mja_edgeBalancedSplit(inOffsets, n, threadCount, bounds);
+
+    double dangling = 0.0;
+    for (int v=0; v<n; v++){
+        long long degree = outOffsets[v+1] - outOffsets[v];
+        invDegree[v] = (degree > 0) ? 1.0 / (double)degree : 0.0;
+        ranks[v] = 1.0 / n;
+        contrib[v] = ranks[v] * invDegree[v];
+        if (degree == 0){
+            dangling += ranks[v];
+        }
+    }
+
+    double* current = ranks; //swapped with nextRanks each iteration rather than copied
+    int iteration = 0;
+    while (iteration < maxIterations){
+        double base = (1.0 - damping) / n + damping * dangling / n;
+        //one pass per iteration, each thread pulls its vertices' new ranks and prepares their contributions for the next iteration
+        auto call = [&](int p){
+            double diff = 0.0;
+            double danglingPart = 0.0;
+            for (int v=bounds[p]; v<bounds[p+1]; v++){
+                double rank = base + damping * mja_gatherSum(inTargets, contrib, inOffsets[v], inOffsets[v+1]);
+                diff += (rank > current[v]) ? rank - current[v] : current[v] - rank;
+                nextRanks[v] = rank;
+                nextContrib[v] = rank * invDegree[v];
+                if (invDegree[v] == 0.0){
+                    danglingPart += rank;
+                }
+            }
+            diffParts[p] = diff;
+            danglingParts[p] = danglingPart;
+        };
+        mja_runParts(threadCount, call);
+        iteration++;
+
+        double diff = 0.0;
+        dangling = 0.0;
+        for (int p=0; p<threadCount; p++){
+            diff += diffParts[p];
+            dangling += danglingParts[p];
+        }
+        double* swap = current;
+        current = nextRanks;
+        nextRanks = swap;
+        swap = contrib;
+        contrib = nextContrib;
+        nextContrib = swap;
+        if (diff < tolerance){
+            break;
+        }
+    }
+    if (current != ranks){ //latest ranks ended up in the internal buffer
+        for (int v=0; v<n; v++){
+            ranks[v] = current[v];
+        }
+        nextRanks = current;
+    }
+
+    delete[] invDegree;
+    delete[] contrib;
+    delete[] nextContrib;
+    delete[] nextRanks;
+    delete[] danglingParts;
+    delete[] diffParts;
+    delete[] bounds;
+    if (ownReverse){
+        delete reverse;
+    }
+    return iteration;
+}
+
+//pagerank with the usual damping of 0.85, a tolerance of 1e-6 and up to 100 iterations on every hardware thread
+inline int mja_pageRank(mja_GraphCSR &graph, mja_GraphCSR* reverse, double* ranks){
+    return mja_pageRank(graph, reverse, ranks, 0.85, 1e-6, 100, 0);
+}
+
+
+#endif
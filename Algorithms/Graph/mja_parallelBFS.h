@@ -0,0 +1,229 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_PARALLELBFS_H
+#define MJA_PARALLELBFS_H
+
+#include "mja_GraphCSR.h"
+#include "mja_graphParallel.h"
+
+//direction optimising breadth first search (Beamer et al.) across multiple threads
+//top down steps push from each frontier vertex to its unvisited neighbours, bottom up steps have each unvisited vertex look for any in neighbour in the frontier
+//bottom up wins once the frontier's edges outnumber a fraction of the unvisited vertices' edges, as most of its checks stop at the first hit
+//top down frontiers are arrays of vertices, bottom up frontiers are bitmaps so membership checks are a single bit test
+
+//switching thresholds from the paper, go bottom up once the frontier has more than 1/ALPHA of the unexplored edges, and back once it has under 1/BETA of the vertices
+static const int MJA_BFS_ALPHA = 14;
+static const int MJA_BFS_BETA = 24;
+
+//bfs from source over a frozen graph, levels[v] is v's hop distance and parents[v] the vertex it was reached from (both -1 if unreached, parents[source] is -1)
+//levels and parents must have room for graph.getVertexCount() values, reverse is graph's transpose (see mja_GraphCSR::transpose),
+//if nullptr it's built and freed internally, so pass it in when running more than one search
+//threadCount of 0 uses every hardware thread, returns the number of vertices reached
+inline int mja_parallelBFS(mja_GraphCSR &graph, mja_GraphCSR* reverse, int source, int* levels, int* parents, int threadCount){
+    int n = graph.getVertexCount();
+    for (int v=0; v<n; v++){
+        levels[v] = -1;
+        parents[v] = -1;
+    }
+    if (source < 0 || source >= n){
+        return 0;
+    }
+    threadCount = mja_resolveThreadCount(threadCount);
+    bool ownReverse = (reverse == nullptr);
+    if (ownReverse){
+        reverse = graph.transpose();
+    }
+    const long long* offsets = graph.getOffsets();
+    const int* targets = graph.getTargets();
+    const long long* inOffsets = reverse->getOffsets();
+    const int* inTargets = reverse->getTargets();
+
+    //the winning compare and swap on a vertex's parent is what visits it, so each vertex joins exactly one frontier
+    std::atomic<int>* parent = new std::atomic<int>[n];
+    for (int v=0; v<n; v++){
+        parent[v].store(-1, std::memory_order_relaxed);
+    }
+    parent[source].store(source, std::memory_order_relaxed);
+    levels[source] = 0;
+
+    int words = (n + 63) / 64;
+    int* frontier = new int[n];
+    int* next = new int[n];
+    unsigned long long* frontBits = new unsigned long long[words];
+    unsigned long long* nextBits = new unsigned long long[words];
+    const int BUFFER = 256; //top down steps collect found vertices per thread and claim space in next once per full buffer
+    int* buffers = new int[threadCount * BUFFER];
+    long long* foundEdges = new long long[threadCount]; //out degree total of each thread's found vertices
+    int* foundCount = new int[threadCount];
+
+    frontier[0] = source;
+    int frontierSize = 1;
+    long long frontierEdges = offsets[source+1] - offsets[source];
+    long long unexploredEdges = graph.getEdgeCount() - frontierEdges;
+    int reached = 1;
+    bool bottomUp = false;
+
+    for (int level=0; frontierSize > 0; level++){
+        //pick the direction, converting the frontier to the other form when switching
+        if (!bottomUp && frontierEdges > unexploredEdges / MJA_BFS_ALPHA){
+            for (int w=0; w<words; w++){
+                frontBits[w] = 0;
+            }
+            for (int i=0; i<frontierSize; i++){
+                frontBits[frontier[i] >> 6] |= 1ULL << (frontier[i] & 63);
+            }
+            bottomUp = true;
+        } else if (bottomUp && frontierSize < n / MJA_BFS_BETA){
+            frontierSize = 0;
+            for (int w=0; w<words; w++){
+                for (unsigned long long bits = frontBits[w]; bits != 0; bits &= bits - 1){
+                    int b = 0;
+                    while (((bits >> b) & 1) == 0){
+                        b++;
+                    }
+                    frontier[frontierSize++] = w * 64 + b;
+                }
+            }
+            bottomUp = false;
+        }
+        for (int t=0; t<threadCount; t++){
+            foundEdges[t] = 0;
+            foundCount[t] = 0;
+        }
+
+        if (bottomUp){
+            for (int w=0; w<words; w++){
+                nextBits[w] = 0;
+            }
+            //chunks are whole bitmap words, so each word of nextBits is only ever written by one thread
+            auto step = [&](int begin, int end, int t){
+                long long edges = 0; //totalled locally so threads aren't writing next to each other every hit
+                int count = 0;
+                for (int w=begin; w<end; w++){
+                    unsigned long long found = 0;
+                    int last = (w * 64 + 64 < n) ? w * 64 + 64 : n;
+                    for (int v=w*64; v<last; v++){
+                        if (parent[v].load(std::memory_order_relaxed) != -1){
+                            continue; //already visited
+                        }
+                        for (long long e=inOffsets[v]; e<inOffsets[v+1]; e++){
+                            int u = inTargets[e];
+                            if ((frontBits[u >> 6] >> (u & 63)) & 1){
+                                parent[v].store(u, std::memory_order_relaxed);
+                                levels[v] = level + 1;
+                                found |= 1ULL << (v & 63);
+                                edges += offsets[v+1] - offsets[v];
+                                count++;
+                                break; //any frontier parent will do
+                            }
+                        }
+                    }
+                    nextBits[w] = found;
+                }
+                foundEdges[t] += edges;
+                foundCount[t] += count;
+            };
+            mja_parallelChunks(words, 16, threadCount, step);
+            unsigned long long* swap = frontBits;
+            frontBits = nextBits;
+            nextBits = swap;
+            frontierSize = 0;
+        } else {
+            std::atomic<int> nextSize(0);
+            int* bufferSizes = new int[threadCount];
+            for (int t=0; t<threadCount; t++){
+                bufferSizes[t] = 0;
+            }
+            auto flush = [&](int t){
+                int at = nextSize.fetch_add(bufferSizes[t], std::memory_order_relaxed);
+                for (int i=0; i<bufferSizes[t]; i++){
+                    next[at + i] = buffers[t * BUFFER + i];
+                }
+                bufferSizes[t] = 0;
+            };
+            auto step = [&](int begin, int end, int t){
+                long long edges = 0;
+                int count = 0;
+                for (int i=begin; i<end; i++){
+                    int u = frontier[i];
+                    for (long long e=offsets[u]; e<offsets[u+1]; e++){
+                        int v = targets[e];
+                        int expected = -1;
+                        if (parent[v].load(std::memory_order_relaxed) == -1 && parent[v].compare_exchange_strong(expected, u, std::memory_order_relaxed)){
+                            levels[v] = level + 1;
+                            edges += offsets[v+1] - offsets[v];
+                            count++;
+                            buffers[t * BUFFER + bufferSizes[t]++] = v; //post increment access
+                            if (bufferSizes[t] == BUFFER){
+                                flush(t);
+                            }
+                        }
+                    }
+                }
+                foundEdges[t] += edges;
+                foundCount[t] += count;
+            };
+            mja_parallelChunks(frontierSize, 64, threadCount, step);
+            for (int t=0; t<threadCount; t++){
+                flush(t); //threads have all joined, so the leftovers can be flushed from here
+            }
+            delete[] bufferSizes;
+            int* swap = frontier;
+            frontier = next;
+            next = swap;
+            frontierSize = 0;
+        }
+
+        frontierEdges = 0;
+        for (int t=0; t<threadCount; t++){
+            frontierSize += foundCount[t];
+            frontierEdges += foundEdges[t];
+        }
+        unexploredEdges -= frontierEdges;
+        reached += frontierSize;
+    }
+
+    for (int v=0; v<n; v++){
+        parents[v] = parent[v].load(std::memory_order_relaxed);
+    }
+    parents[source] = -1;
+    delete[] parent;
+    delete[] frontier;
+    delete[] next;
+    delete[] frontBits;
+    delete[] nextBits;
+    delete[] buffers;
+    delete[] foundEdges;
+    delete[] foundCount;
+    if (ownReverse){
+        delete reverse;
+    }
+    return reached;
+}
+
+
+#endif
@@ -0,0 +1,233 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_REORDER_H
+#define MJA_REORDER_H
+
+#include "mja_GraphCSR.h"
+#include "mja_insertionSort.h"
+#include "mja_mergeSort.h"
+
+//vertex reorderings for frozen graphs, so vertices that are used together sit close together in memory
+//each ordering gives newIndex[old dense index] = new dense index, and mja_permuteGraph relabels a graph with one
+//the permuted graph keeps every vertex's unique ID, so getID/getIndex on it map between unique IDs and the new indices
+//orderings treat edges as undirected, since both pushing along out edges and pulling along in edges benefit
+
+//orderings accepted by mja_reorder
+class mja_ConfigCode_Reorder {
+
+public:
+
+    static const int ORDER_RCM = 0; //reverse Cuthill-McKee, keeps neighbours' indices close together (small bandwidth)
+    static const int ORDER_DEGREE = 1; //highest total degree first, packs the most used vertices into the fewest cache lines
+    static const int ORDER_BFS = 2; //breadth first discovery order, neighbours land in the same or the next level's run of indices
+};
+
+//ascending order for the sorts, keys are degree (or any rank) in the top 32 bits and the vertex in the bottom 32 bits
+inline bool mja_reorderSortOp(unsigned long long a, unsigned long long b){
+    return a > b;
+}
+
+//in + out degree of every vertex, reverse is graph's transpose
+inline int* mja_reorderDegrees(mja_GraphCSR &graph, mja_GraphCSR &reverse){
+    int n = graph.getVertexCount();
+    int* degrees = new int[n];
+    for (int v=0; v<n; v++){
+        degrees[v] = graph.getDegree(v) + reverse.getDegree(v);
+    }
+    return degrees;
+}
+
+//breadth first ordering over the undirected graph, Cuthill-McKee when byDegree is true (each vertex's newly found neighbours are visited lowest degree first)
+//each component starts from its lowest degree vertex (found by walking the vertices in degree order), fills order with old indices in visiting order
+inline void mja_reorderSearch(mja_GraphCSR &graph, mja_GraphCSR &reverse, const int* degrees, bool byDegree, int* order){
+    int n = graph.getVertexCount();
+    unsigned long long* starts = new unsigned long long[n]; //vertices in ascending degree order, ties broken by index
+    for (int v=0; v<n; v++){
+        starts[v] = ((unsigned long long)(unsigned int)degrees[v] << 32) | (unsigned long long)(unsigned int)v;
+    }
+    mja_mergeSort(starts, 0, n, mja_reorderSortOp);
+    bool* visited = new bool[n];
+    for (int v=0; v<n; v++){
+        visited[v] = false;
+    }
+    unsigned long long* keys = new unsigned long long[n]; //sort scratch for each vertex's newly found neighbours
+    mja_GraphCSR* sides[2] = {&graph, &reverse};
+    int tail = 0; //order doubles as the queue, everything before tail has been found
+    for (int s=0; s<n; s++){
+        int start = (int)(starts[s] & 0xFFFFFFFFULL);
+        if (visited[start]){
+            continue;
+        }
+        visited[start] = true;
+        order[tail++] = start; //post increment access
+        for (int head = tail - 1; head < tail; head++){
+            int u = order[head];
+            int found = tail;
+            for (int side=0; side<2; side++){
+                const long long* offsets = sides[side]->getOffsets();
+                const int* targets = sides[side]->getTargets();
+                for (long long e=offsets[u]; e<offsets[u+1]; e++){
+                    int v = targets[e];
+                    if (!visited[v]){
+                        visited[v] = true;
+                        order[tail++] = v; //post increment access
+                    }
+                }
+            }
+            int count = tail - found;
+            if (byDegree && count > 1){
+                for (int i=0; i<count; i++){
+                    int v = order[found + i];
+                    keys[i] = ((unsigned long long)(unsigned int)degrees[v] << 32) | (unsigned long long)(unsigned int)v;
+                }
+                if (count <= 32){
+                    mja_insertionSort(keys, count, mja_reorderSortOp); //most vertices only find a handful of new neighbours
+                } else {
+                    mja_mergeSort(keys, 0, count, mja_reorderSortOp);
+                }
+                for (int i=0; i<count; i++){
+                    order[found + i] = (int)(keys[i] & 0xFFFFFFFFULL);
+                }
+            }
+        }
+    }
+    delete[] starts;
+    delete[] visited;
+    delete[] keys;
+}
+
+//computes newIndex[old] = new for one of mja_ConfigCode_Reorder's orderings, newIndex must have room for graph.getVertexCount() values
+//reverse is graph's transpose (see mja_GraphCSR::transpose), if nullptr it's built and freed internally
+inline void mja_reorderIndices(mja_GraphCSR &graph, mja_GraphCSR* reverse, int orderType, int* newIndex){
+    int n = graph.getVertexCount();
+    bool ownReverse = (reverse == nullptr);
+    if (ownReverse){
+        reverse = graph.transpose();
+    }
+    int* degrees = mja_reorderDegrees(graph, *reverse);
+    int* order = new int[n]; //order[new] = old
+    if (orderType == mja_ConfigCode_Reorder::ORDER_DEGREE){
+        //ascending sort of the bitwise inverted degrees gives highest degree first, ties stay in index order
+        unsigned long long* keys = new unsigned long long[n];
+        for (int v=0; v<n; v++){
+            keys[v] = ((unsigned long long)(~(unsigned int)degrees[v]) << 32) | (unsigned long long)(unsigned int)v;
+        }
+        mja_mergeSort(keys, 0, n, mja_reorderSortOp);
+        for (int i=0; i<n; i++){
+            order[i] = (int)(keys[i] & 0xFFFFFFFFULL);
+        }
+        delete[] keys;
+    } else if (orderType == mja_ConfigCode_Reorder::ORDER_BFS){
+        mja_reorderSearch(graph, *reverse, degrees, false, order);
+    } else {
+        mja_reorderSearch(graph, *reverse, degrees, true, order);
+        for (int i=0; i<n/2; i++){ //reversing Cuthill-McKee's order gives the same bandwidth but less fill in
+            int temp = order[i];
+            order[i] = order[n-1-i];
+            order[n-1-i] = temp;
+        }
+    }
+    for (int i=0; i<n; i++){
+        newIndex[order[i]] = i;
+    }
+    delete[] order;
+    delete[] degrees;
+    if (ownReverse){
+        delete reverse;
+    }
+}
+
+//returns a copy of graph with vertex v moved to newIndex[v] (caller must delete it), newIndex must be a permutation of 0 to vertexCount-1
+//each row's edges are put in ascending destination order, so walking a row reads the other vertices' data front to back
+inline mja_GraphCSR* mja_permuteGraph(mja_GraphCSR &graph, const int* newIndex){
+    int n = graph.getVertexCount();
+    long long m = graph.getEdgeCount();
+    const unsigned int* ids = graph.getIDs();
+    const long long* offsets = graph.getOffsets();
+    const int* targets = graph.getTargets();
+    const double* weights = graph.getWeights();
+    int* order = new int[n]; //order[new] = old
+    for (int v=0; v<n; v++){
+        order[newIndex[v]] = v;
+    }
+    unsigned int* newIDs = new unsigned int[n];
+    long long* newOffsets = new long long[n + 1];
+    int* newTargets = new int[m];
+    double* newWeights = new double[m];
+    newOffsets[0] = 0;
+    for (int i=0; i<n; i++){
+        newIDs[i] = ids[order[i]];
+        newOffsets[i+1] = newOffsets[i] + graph.getDegree(order[i]);
+    }
+    int maxRow = 1;
+    for (int v=0; v<n; v++){
+        if (graph.getDegree(v) > maxRow){
+            maxRow = graph.getDegree(v);
+        }
+    }
+    unsigned long long* keys = new unsigned long long[maxRow]; //(new target, old edge position) pairs for sorting a row
+    for (int i=0; i<n; i++){
+        int old = order[i];
+        int degree = (int)(offsets[old+1] - offsets[old]);
+        for (int k=0; k<degree; k++){
+            keys[k] = ((unsigned long long)(unsigned int)newIndex[targets[offsets[old] + k]] << 32) | (unsigned long long)(unsigned int)k;
+        }
+        if (degree <= 32){
+            mja_insertionSort(keys, degree, mja_reorderSortOp);
+        } else {
+            mja_mergeSort(keys, 0, degree, mja_reorderSortOp);
+        }
+        for (int k=0; k<degree; k++){
+            long long from = offsets[old] + (long long)(keys[k] & 0xFFFFFFFFULL);
+            newTargets[newOffsets[i] + k] = (int)(keys[k] >> 32);
+            newWeights[newOffsets[i] + k] = weights[from];
+        }
+    }
+    delete[] keys;
+    delete[] order;
+    return new mja_GraphCSR(n, m, newIDs, newOffsets, newTargets, newWeights);
+}
+
+//reorders a frozen graph, returns the permuted copy (caller must delete it)
+//newIndex (can be nullptr) gets newIndex[old dense index] = new dense index, so per vertex arrays can be carried across
+inline mja_GraphCSR* mja_reorder(mja_GraphCSR &graph, int orderType, int* newIndex){
+    int* indices = (newIndex != nullptr) ? newIndex : new int[graph.getVertexCount()];
+    mja_reorderIndices(graph, nullptr, orderType, indices);
+    mja_GraphCSR* output = mja_permuteGraph(graph, indices);
+    if (newIndex == nullptr){
+        delete[] indices;
+    }
+    return output;
+}
+
+//reverse Cuthill-McKee reordering
+inline mja_GraphCSR* mja_reorder(mja_GraphCSR &graph){
+    return mja_reorder(graph, mja_ConfigCode_Reorder::ORDER_RCM, nullptr);
+}
+
+
+#endif
@@ -0,0 +1,238 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_SPANNINGTREE_H
+#define MJA_SPANNINGTREE_H
+
+#include "mja_GraphCSR.h"
+#include "mja_UnionFind.h"
+#include "mja_radixSort.h"
+#include "mja_graphParallel.h"
+
+//minimum spanning forests of frozen graphs (freeze an mja_GraphAdjList first), edges are treated as undirected
+//so u->v and v->u are the same connection and only the lighter of them can be picked
+//both return the picked edges as a new array (caller must delete[]), or nullptr if there are none, with edgeCount and totalWeight set
+//a graph with k weakly connected components gives vertexCount - k edges, use graph.getID to turn the dense indices back into unique IDs
+
+//one edge of a spanning forest, src and dest are dense vertex indices in the direction the edge is stored in the graph
+struct mja_TreeEdge {
+    int src;
+    int dest;
+    double weight;
+};
+
+//radix sort key, ascending by weight
+inline unsigned long long mja_treeEdgeKey(mja_TreeEdge edge){
+    return mja_radixKey(edge.weight);
+}
+
+//Kruskal's algorithm, every edge is radix sorted by weight then added lightest first unless its ends are already connected
+inline mja_TreeEdge* mja_kruskal(mja_GraphCSR &graph, int &edgeCount, double &totalWeight){
+    int n = graph.getVertexCount();
+    long long m = graph.getEdgeCount();
+    const long long* offsets = graph.getOffsets();
+    const int* targets = graph.getTargets();
+    const double* weights = graph.getWeights();
+    edgeCount = 0;
+    totalWeight = 0.0;
+
+    mja_TreeEdge* edges = new mja_TreeEdge[m > 0 ? m : 1];
+    long long count = 0; //long long like the graph's edge count, there can be more than INT_MAX edges
+    for (int u=0; u<n; u++){
+        for (long long e=offsets[u]; e<offsets[u+1]; e++){
+            if (targets[e] != u){ //self loops can never be picked
+                edges[count].src = u;
+                edges[count].dest = targets[e];
+                edges[count].weight = weights[e];
+                count++;
+            }
+        }
+    }
+    mja_radixSort(edges, count, mja_treeEdgeKey);
+
+    mja_UnionFind sets(n);
+    mja_TreeEdge* output = new mja_TreeEdge[n > 1 ? n - 1 : 1];
+    for (long long i=0; i<count && sets.getSetCount() > 1; i++){
+        if (sets.unite(edges[i].src, edges[i].dest)){
+            output[edgeCount++] = edges[i]; //post increment access
+            totalWeight += edges[i].weight;
+        }
+    }
+    delete[] edges;
+    if (edgeCount == 0){
+        delete[] output;
+        return nullptr;
+    }
+    return output;
+}
+
+//Borůvka's algorithm across multiple threads, every round each component picks its lightest edge to another component and all of them are added at once
+//components at least halve each round so there are at most log2(vertexCount) rounds, each one a parallel pass over the edges
+//ties are broken by the pair of vertices an edge joins so every component agrees on one order, which stops the picked edges from forming a cycle
+//reverse is graph's transpose (see mja_GraphCSR::transpose), if nullptr it's built and freed internally
+//threadCount of 0 uses every hardware thread, the picked edges come out in no particular order
+inline mja_TreeEdge* mja_boruvka(mja_GraphCSR &graph, mja_GraphCSR* reverse, int &edgeCount, double &totalWeight, int threadCount){
+    int n = graph.getVertexCount();
+    edgeCount = 0;
+    totalWeight = 0.0;
+    if (n < 2){
+        return nullptr;
+    }
+    bool ownReverse = (reverse == nullptr);
+    if (ownReverse){
+        reverse = graph.transpose();
+    }
+    //each side gives every vertex both its out and its in edges, in edges are numbered after the out edges for tie breaking
+    mja_GraphCSR* sides[2] = {&graph, reverse};
+    long long m = graph.getEdgeCount();
+    threadCount = mja_resolveThreadCount(threadCount);
+    if (threadCount > n){
+        threadCount = n;
+    }
+    int* bounds[2];
+    for (int side=0; side<2; side++){
+        bounds[side] = new int[threadCount + 1];
+        mja_edgeBalancedSplit(sides[side]->getOffsets(), n, threadCount, bounds[side]);
+    }
+
+    mja_ConcurrentUnionFind sets(n);
+    int* comp = new int[n]; //component of each vertex at the start of the round
+    std::atomic<long long>* best = new std::atomic<long long>[n]; //lightest edge out of each component found so far, -1 if none
+    mja_TreeEdge* output = new mja_TreeEdge[n - 1];
+    std::atomic<int> picked(0);
+
+    int* edgeSource = new int[2 * m > 0 ? 2 * m : 1]; //the vertex each edge id hangs off, so a component's best edge can be turned back into a pair of vertices
+    for (int side=0; side<2; side++){
+        const long long* offsets = sides[side]->getOffsets();
+        for (int u=0; u<n; u++){
+            for (long long e=offsets[u]; e<offsets[u+1]; e++){
+                edgeSource[side * m + e] = u;
+            }
+        }
+    }
+
+    //edge ids run over the out edges then the in edges, so an edge is identified by its side and position
+    auto weightOf = [&](long long id){
+        return (id < m) ? graph.getWeights()[id] : reverse->getWeights()[id - m];
+    };
+    auto targetOf = [&](long long id){
+        return (id < m) ? graph.getTargets()[id] : reverse->getTargets()[id - m];
+    };
+    //an edge and its reverse have different ids but join the same pair, so ties compare the (smaller, larger) vertex pair rather than the ids
+    auto pairOf = [&](long long id){
+        unsigned int a = (unsigned int)edgeSource[id];
+        unsigned int b = (unsigned int)targetOf(id);
+        return (a < b) ? (((unsigned long long)a << 32) | b) : (((unsigned long long)b << 32) | a);
+    };
+    auto lighter = [&](long long a, long long b){
+        double wa = weightOf(a);
+        double wb = weightOf(b);
+        return (wa != wb) ? (wa < wb) : (pairOf(a) < pairOf(b));
+    };
+
+    bool merged = true;
+    while (merged){
+        auto findPart = [&](int p){
+            for (int v=bounds[0][p]; v<bounds[0][p+1]; v++){
+                comp[v] = sets.find(v);
+                best[v].store(-1, std::memory_order_relaxed);
+            }
+        };
+        mja_runParts(threadCount, findPart);
+
+        //every edge between two components offers itself to the component it leaves
+        auto scanPart = [&](int p){
+            for (int side=0; side<2; side++){
+                const long long* offsets = sides[side]->getOffsets();
+                const int* targets = sides[side]->getTargets();
+                for (int u=bounds[side][p]; u<bounds[side][p+1]; u++){
+                    int cu = comp[u];
+                    for (long long e=offsets[u]; e<offsets[u+1]; e++){
+                        if (comp[targets[e]] == cu){
+                            continue; //inside the component (or a self loop)
+                        }
+                        long long id = side * m + e;
+                        long long current = best[cu].load(std::memory_order_relaxed);
+                        while ((current == -1 || lighter(id, current)) && !best[cu].compare_exchange_weak(current, id, std::memory_order_relaxed)){
+                            //current has been reloaded, try again while this edge is still lighter
+                        }
+                    }
+                }
+            }
+        };
+        mja_runParts(threadCount, scanPart);
+
+        //every component adds its best edge, a pair of components that picked each other's edge only gets it once as the second unite fails
+        std::atomic<bool> anyMerged(false);
+        auto mergePart = [&](int p){
+            for (int v=bounds[0][p]; v<bounds[0][p+1]; v++){
+                long long id = best[v].load(std::memory_order_relaxed);
+                if (comp[v] != v || id == -1){
+                    continue;
+                }
+                int side = (id < m) ? 0 : 1;
+                int a = edgeSource[id];
+                int b = targetOf(id);
+                if (sets.unite(a, b)){
+                    int slot = picked.fetch_add(1, std::memory_order_relaxed);
+                    //in edges are stored reversed, flip them back to the graph's direction
+                    output[slot].src = (side == 0) ? a : b;
+                    output[slot].dest = (side == 0) ? b : a;
+                    output[slot].weight = weightOf(id);
+                    anyMerged.store(true, std::memory_order_relaxed);
+                }
+            }
+        };
+        mja_runParts(threadCount, mergePart);
+        merged = anyMerged.load();
+    }
+
+    edgeCount = picked.load();
+    for (int i=0; i<edgeCount; i++){
+        totalWeight += output[i].weight;
+    }
+    delete[] bounds[0];
+    delete[] bounds[1];
+    delete[] comp;
+    delete[] best;
+    delete[] edgeSource;
+    if (ownReverse){
+        delete reverse;
+    }
+    if (edgeCount == 0){
+        delete[] output;
+        return nullptr;
+    }
+    return output;
+}
+
+//parallel Borůvka on every hardware thread
+inline mja_TreeEdge* mja_boruvka(mja_GraphCSR &graph, int &edgeCount, double &totalWeight){
+    return mja_boruvka(graph, nullptr, edgeCount, totalWeight, 0);
+}
+
+
+#endif
@@ -0,0 +1,104 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_RADIXSORT_H
+#define MJA_RADIXSORT_H
+
+#include <cstring> //needed for reading a double's bits
+
+//least significant digit radix sort on 64 bit keys, ascending and stable, O(length) for each byte of key that isn't the same in every item
+//rather than a comparison the sort takes keyOp, which gives each item's key (see mja_radixKey for turning numbers into keys that sort in order)
+//uses a buffer the size of data, and a single pass up front counts every byte position so passes that wouldn't move anything are skipped
+//length is a long long as nothing here halves index sums, so it can sort the edge arrays of graphs with over INT_MAX edges
+template <typename T>
+void mja_radixSort(T* data, long long length, unsigned long long(*keyOp)(T)){
+
+    if (length < 2){
+        return;
+    }
+
+    //count every byte position's digits in one go
+    long long* counts = new long long[8 * 256];
+    for (int i=0; i<8*256; i++){
+        counts[i] = 0;
+    }
+    for (long long i=0; i<length; i++){
+        unsigned long long key = keyOp(data[i]);
+        for (int b=0; b<8; b++){
+            counts[b*256 + (int)((key >> (b*8)) & 0xFF)]++;
+        }
+    }
+
+    T* buffer = new T[length];
+    T* from = data;
+    T* to = buffer;
+    for (int b=0; b<8; b++){
+        long long* count = &(counts[b*256]);
+        if (count[(int)((keyOp(from[0]) >> (b*8)) & 0xFF)] == length){
+            continue; //every item has the same digit here, this pass wouldn't change the order
+        }
+        //turn the counts into starting positions, then place the items in order
+        long long total = 0;
+        for (int d=0; d<256; d++){
+            long long temp = count[d];
+            count[d] = total;
+            total += temp;
+        }
+        for (long long i=0; i<length; i++){
+            int d = (int)((keyOp(from[i]) >> (b*8)) & 0xFF);
+            to[count[d]++] = from[i]; //post increment access
+        }
+        T* temp = from;
+        from = to;
+        to = temp;
+    }
+    if (from != data){ //odd number of passes, the sorted items are sat in the buffer
+        for (long long i=0; i<length; i++){
+            data[i] = from[i];
+        }
+    }
+
+    delete[] buffer;
+    delete[] counts;
+}
+
+//keys that sort in the same order as the numbers they come from
+inline unsigned long long mja_radixKey(unsigned long long value){
+    return value;
+}
+inline unsigned long long mja_radixKey(long long value){
+    return (unsigned long long)value ^ 0x8000000000000000ULL; //flipping the sign bit puts negatives first
+}
+inline unsigned long long mja_radixKey(double value){
+    unsigned long long bits;
+    std::memcpy(&bits, &value, sizeof(double));
+    //negatives have every bit flipped so larger magnitudes come first, positives just get the sign bit set so they come after
+    return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+}
+
+
+
+#endif
@@ -0,0 +1,155 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_CONCURRENTLRUCACHE_H
+#define MJA_CONCURRENTLRUCACHE_H
+
+#include "mja_LRUCache.h"
+#include <mutex> //needed for the per shard locks
+#include <thread> //needed for the default shard count
+
+//thread safe LRU cache, keys are split between shards that each have their own LRU cache and lock
+//every hit reorders its shard's recency list, so shards use a plain mutex rather than a reader-writer lock
+//recency and eviction are per shard, so the cache as a whole only approximates LRU
+template<typename Tobj, typename Tkey, typename Thash = mja_Hash<Tkey>>
+class mja_ConcurrentLRUCache : mja_ErrorCode_HashTable {
+
+private:
+
+    //each shard sits on its own cache line so threads working on neighbouring shards don't fight over the locks
+    struct alignas(64) Shard {
+        std::mutex lock;
+        mja_LRUCache<Tobj, Tkey, Thash>* cache = nullptr;
+    };
+
+    Shard* shards;
+    int shardCount; //always a power of 2
+    Thash hasher; //hash function object, shared with every shard's cache
+
+    //picks a shard using the top bits of the hash, the shard's own lookup table uses the low bits for its buckets
+    Shard& getShard(Tkey key){
+        return shards[(int)((hasher(key) >> 40) & (unsigned long long)(shardCount - 1))];
+    };
+
+public:
+
+    //shardCount of 0 uses 4 shards per hardware thread, capacity is split evenly between the shards
+    mja_ConcurrentLRUCache(int shardCount, int capacity, Thash hasher, bool safeDestruction);
+    mja_ConcurrentLRUCache(int capacity, Thash hasher) : mja_ConcurrentLRUCache(0, capacity, hasher, false) {}; //default setting is to destruct all stored items on eviction/exit
+    mja_ConcurrentLRUCache(int capacity) : mja_ConcurrentLRUCache(0, capacity, Thash(), false) {}; //default hasher
+    mja_ConcurrentLRUCache(mja_ConcurrentLRUCache<Tobj, Tkey, Thash> &oldCache) = delete; //locks can't be copied
+
+    ~mja_ConcurrentLRUCache(){
+        for (int i=0; i<shardCount; i++){
+            delete shards[i].cache;
+        }
+        delete[] shards;
+    };
+
+    int getShardCount(){return shardCount;};
+    int getKeyCount(); //total across all shards, only a snapshot if other threads are writing
+
+    //eviction callback, called while the evicting shard is locked so it mustn't use this cache
+    void setEvictFunc(void(*evictFunc)(Tobj*, Tkey));
+
+    //cached items can be evicted by any other thread's add, so items are only ever handed out as copies
+    int getCopy(Tkey key, Tobj &output); //marks the key as most recently used
+    int peekCopy(Tkey key, Tobj &output); //doesn't change the recency order
+
+    int add(Tobj* obj, Tkey key){Shard& s = getShard(key); std::lock_guard<std::mutex> guard(s.lock); return s.cache->add(obj, key);};
+    int rem(Tkey key){Shard& s = getShard(key); std::lock_guard<std::mutex> guard(s.lock); return s.cache->rem(key);};
+    Tobj* pop(Tkey key){Shard& s = getShard(key); std::lock_guard<std::mutex> guard(s.lock); return s.cache->pop(key);};
+};
+
+/*
+more lengthy/looping functions are defined below to prevent above main header getting spammed
+*/
+
+//base constructor
+template <typename Tobj, typename Tkey, typename Thash>
+mja_ConcurrentLRUCache<Tobj, Tkey, Thash> :: mja_ConcurrentLRUCache(int shardCount, int capacity, Thash hasher, bool safeDestruction) : hasher(hasher) {
+    if (shardCount <= 0){
+        shardCount = 4 * (int)std::thread::hardware_concurrency();
+    }
+    this->shardCount = 1;
+    while (this->shardCount < shardCount){
+        this->shardCount *= 2; //round up to a power of 2 so the shard can be masked out of the hash
+    }
+    int shardCapacity = (capacity + this->shardCount - 1) / this->shardCount; //round up so the total capacity is never below what was asked for
+    this->shards = new Shard[this->shardCount];
+    for (int i=0; i<this->shardCount; i++){
+        shards[i].cache = new mja_LRUCache<Tobj, Tkey, Thash>(shardCapacity, hasher, safeDestruction);
+    }
+};
+
+//sums up the key count of every shard
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_ConcurrentLRUCache<Tobj, Tkey, Thash> :: getKeyCount(){
+    int output = 0;
+    for (int i=0; i<shardCount; i++){
+        std::lock_guard<std::mutex> guard(shards[i].lock);
+        output += shards[i].cache->getKeyCount();
+    }
+    return output;
+};
+
+//sets the eviction callback on every shard
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_ConcurrentLRUCache<Tobj, Tkey, Thash> :: setEvictFunc(void(*evictFunc)(Tobj*, Tkey)){
+    for (int i=0; i<shardCount; i++){
+        std::lock_guard<std::mutex> guard(shards[i].lock);
+        shards[i].cache->setEvictFunc(evictFunc);
+    }
+};
+
+//copies out a cached item while its shard is locked, and marks it as most recently used
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_ConcurrentLRUCache<Tobj, Tkey, Thash> :: getCopy(Tkey key, Tobj &output){
+    Shard& s = getShard(key);
+    std::lock_guard<std::mutex> guard(s.lock);
+    Tobj* obj = s.cache->get(key);
+    if (obj != nullptr){
+        output = *obj;
+        return SUCCESS;
+    }
+    return NON_EXIST_KEY; //indicate that item wasn't found
+};
+
+//copies out a cached item while its shard is locked, leaving the recency order alone
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_ConcurrentLRUCache<Tobj, Tkey, Thash> :: peekCopy(Tkey key, Tobj &output){
+    Shard& s = getShard(key);
+    std::lock_guard<std::mutex> guard(s.lock);
+    Tobj* obj = s.cache->peek(key);
+    if (obj != nullptr){
+        output = *obj;
+        return SUCCESS;
+    }
+    return NON_EXIST_KEY; //indicate that item wasn't found
+};
+
+
+#endif
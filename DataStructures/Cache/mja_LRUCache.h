@@ -0,0 +1,215 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_LRUCACHE_H
+#define MJA_LRUCACHE_H
+
+#include "mja_HashTable.h" //shares the hash table error codes
+#include "mja_LinkedList.h"
+
+//bounded least recently used cache, once capacity is reached adding a new key evicts the key that was used longest ago
+//a hash table finds each key's node in a recency list, so get, add and eviction are all O(1)
+template<typename Tobj, typename Tkey, typename Thash = mja_Hash<Tkey>>
+class mja_LRUCache : mja_ErrorCode_HashTable {
+
+private:
+
+    //stored in both the recency list and the lookup table, the list owns it
+    struct Entry {
+        Tkey key;
+        Tobj* obj;
+        mja_NodeLL<Entry>* node = nullptr; //node in the recency list, lets a hit move straight to the front
+    };
+
+    mja_LinkedList<Entry> recency; //most recently used at the front, least recently used at the end
+    mja_HashTable<Entry, Tkey, Thash>* lookup; //safe destruction, entries are only ever destroyed by the recency list
+    int capacity;
+    bool safeDestruction; //if true then stored items are not destroyed when evicted, removed or when the cache is destroyed
+    Thash hasher; //kept so copies hash keys the same way
+    void (*evictFunc)(Tobj*, Tkey) = nullptr; //called on every evicted item, before it's destroyed (unless safe destruction is on)
+
+    //moves an entry's node to the front of the recency list
+    void touch(Entry* entry){
+        if (entry->node != recency.getFirstNode()){
+            recency.splice(recency.getFirstNode(), recency, entry->node, entry->node, 1);
+        }
+    };
+
+    void evict(); //evicts the least recently used entry
+    void release(Entry* entry); //unlinks an entry that's already been popped from the lookup table, leaving its object alone
+
+public:
+
+    //base constructor, capacity is the most items the cache holds before evicting
+    mja_LRUCache(int capacity, Thash hasher, bool safeDestruction);
+    mja_LRUCache(int capacity, Thash hasher) : mja_LRUCache(capacity, hasher, false) {}; //default setting is to destruct all stored items on eviction/exit
+    mja_LRUCache(int capacity) : mja_LRUCache(capacity, Thash(), false) {}; //default hasher
+    mja_LRUCache(mja_LRUCache<Tobj, Tkey, Thash> &oldCache); //copy constructor, keeps the recency order
+
+    ~mja_LRUCache(){
+        clearAll();
+        delete lookup;
+    };
+
+    int getKeyCount(){return recency.getNodeCount();};
+    int getCapacity(){return capacity;};
+    Tkey* getKeys(); //returns all the stored keys, most recently used first
+
+    //eviction callback, lets the owner write back or take ownership of evicted items
+    void setEvictFunc(void(*evictFunc)(Tobj*, Tkey)){this->evictFunc = evictFunc;};
+
+    Tobj* get(Tkey key){Entry* entry = lookup->get(key); if (entry == nullptr){return nullptr;} touch(entry); return entry->obj;}; //marks the key as most recently used
+    Tobj* peek(Tkey key){Entry* entry = lookup->get(key); return (entry != nullptr) ? entry->obj : nullptr;}; //doesn't change the recency order
+
+    int add(Tobj* obj, Tkey key); //adds object to that key as the most recently used, if the key already exists then the old object is overwritten
+    int rem(Tkey key);
+    Tobj* pop(Tkey key);
+    void clearAll(); //removes every item, without calling the eviction callback
+};
+
+/*
+more lengthy/looping functions are defined below to prevent above main header getting spammed
+*/
+
+//base constructor
+template <typename Tobj, typename Tkey, typename Thash>
+mja_LRUCache<Tobj, Tkey, Thash> :: mja_LRUCache(int capacity, Thash hasher, bool safeDestruction) : hasher(hasher) {
+    this->capacity = (capacity > 0) ? capacity : 1;
+    this->safeDestruction = safeDestruction;
+    this->lookup = new mja_HashTable<Entry, Tkey, Thash>(this->capacity, hasher, true);
+};
+
+//copy constructor, adds copies from least to most recently used so the copy ends up in the same order
+template <typename Tobj, typename Tkey, typename Thash>
+mja_LRUCache<Tobj, Tkey, Thash> :: mja_LRUCache(mja_LRUCache<Tobj, Tkey, Thash> &oldCache) : mja_LRUCache(oldCache.capacity, oldCache.hasher, oldCache.safeDestruction) {
+    evictFunc = oldCache.evictFunc;
+    for (mja_NodeLL<Entry>* node = oldCache.recency.getLastNode(); node != nullptr; node = node->getPrev()){
+        add((node->obj->obj != nullptr) ? new Tobj(*(node->obj->obj)) : nullptr, node->obj->key);
+    }
+};
+
+//takes an entry off the recency list, the list destroys the entry but its object is left to the caller
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_LRUCache<Tobj, Tkey, Thash> :: release(Entry* entry){
+    entry->obj = nullptr;
+    recency.remNode(entry->node);
+};
+
+//evicts the least recently used entry, the callback sees the item before it's destroyed
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_LRUCache<Tobj, Tkey, Thash> :: evict(){
+    Entry* entry = recency.getLastNode()->obj;
+    lookup->pop(entry->key);
+    Tobj* obj = entry->obj;
+    Tkey key = entry->key;
+    release(entry);
+    if (evictFunc != nullptr){
+        evictFunc(obj, key);
+    }
+    if (!safeDestruction && obj != nullptr){
+        delete obj;
+    }
+};
+
+//returns all the stored keys, most recently used first
+template <typename Tobj, typename Tkey, typename Thash>
+Tkey* mja_LRUCache<Tobj, Tkey, Thash> :: getKeys(){
+    if (recency.isEmpty()){
+        return nullptr; //no keys stored to return
+    }
+    Tkey* output = new Tkey[recency.getNodeCount()];
+    int kCount = 0;
+    for (mja_NodeLL<Entry>* node = recency.getFirstNode(); node != nullptr; node = node->getNext()){
+        output[kCount++] = node->obj->key;
+    }
+    return output;
+};
+
+//adds an item as the most recently used, evicting the least recently used item if the cache is full
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_LRUCache<Tobj, Tkey, Thash> :: add(Tobj* obj, Tkey key){
+    Entry* entry = lookup->get(key);
+    if (entry != nullptr){ //item is already bound to that key, replace it
+        if (!safeDestruction && entry->obj != nullptr && entry->obj != obj){
+            delete entry->obj;
+        }
+        entry->obj = obj;
+        touch(entry);
+        return KEY_OVERWRITTEN;
+    }
+    if (recency.getNodeCount() >= capacity){
+        evict();
+    }
+    entry = new Entry{key, obj};
+    recency.addFront(entry);
+    entry->node = recency.getFirstNode();
+    lookup->add(entry, key);
+    return SUCCESS;
+};
+
+//remove and deallocate an item if stored inside of the cache (left alone if safe destruction is on)
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_LRUCache<Tobj, Tkey, Thash> :: rem(Tkey key){
+    Entry* entry = lookup->pop(key);
+    if (entry == nullptr){
+        return NON_EXIST_KEY; //indicate that item wasn't found
+    }
+    Tobj* obj = entry->obj;
+    release(entry);
+    if (!safeDestruction && obj != nullptr){
+        delete obj;
+    }
+    return SUCCESS; //indicate that item was removed successfully
+};
+
+//remove an item from the cache and return a pointer to it
+template <typename Tobj, typename Tkey, typename Thash>
+Tobj* mja_LRUCache<Tobj, Tkey, Thash> :: pop(Tkey key){
+    Entry* entry = lookup->pop(key);
+    if (entry == nullptr){
+        return nullptr; //not found return nullptr
+    }
+    Tobj* output = entry->obj;
+    release(entry);
+    return output;
+};
+
+//empties the cache, items are destroyed unless safe destruction is on
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_LRUCache<Tobj, Tkey, Thash> :: clearAll(){
+    while (!recency.isEmpty()){
+        Entry* entry = recency.getFirst();
+        lookup->pop(entry->key);
+        Tobj* obj = entry->obj;
+        release(entry);
+        if (!safeDestruction && obj != nullptr){
+            delete obj;
+        }
+    }
+};
+
+
+#endif
@@ -0,0 +1,258 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_BLOOMFILTER_H
+#define MJA_BLOOMFILTER_H
+
+#include "mja_Hash.h"
+
+//probabilistic set membership, mayContain never gives a false negative but can give a false positive
+//both filters are blocked, every key's bits live in one 64 byte block so a lookup touches a single cache line
+//a block is 8 lanes of 64 bits and each key sets one bit (or counter) per lane, picked by multiplying the hash by a per lane salt,
+//so the 8 lanes are independent and the loops over them vectorise
+
+//lane salts, odd constants taken from the split block Bloom filter used by Parquet
+static const unsigned int MJA_BLOOM_SALTS[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+//blocked Bloom filter, keys can't be removed
+template <typename Tkey, typename Thash = mja_Hash<Tkey>>
+class mja_BloomFilter {
+
+private:
+
+    struct alignas(64) Block {
+        unsigned long long lanes[8];
+    };
+
+    Block* blocks;
+    unsigned long long blockCount;
+    Thash hasher; //hash function object, only used by the key versions of the functions
+
+    //picks a block using the top 32 bits of the hash, multiply and shift avoids needing a power of 2 block count
+    Block& getBlock(unsigned long long hash){
+        return blocks[((hash >> 32) * blockCount) >> 32];
+    };
+
+public:
+
+    //sized for expectedKeys at bitsPerKey bits each, 10 bits per key gives roughly a 1% false positive rate
+    mja_BloomFilter(int expectedKeys, int bitsPerKey, Thash hasher);
+    mja_BloomFilter(int expectedKeys, int bitsPerKey) : mja_BloomFilter(expectedKeys, bitsPerKey, Thash()) {};
+    mja_BloomFilter(int expectedKeys) : mja_BloomFilter(expectedKeys, 10, Thash()) {};
+    mja_BloomFilter(mja_BloomFilter<Tkey, Thash> &oldFilter); //copy constructor
+
+    ~mja_BloomFilter(){delete[] blocks;};
+
+    unsigned long long getBlockCount(){return blockCount;};
+    void clear(); //empties the filter
+
+    //hash versions, for callers that already have a 64 bit hash (e.g. one stored by a hash table)
+    void addHash(unsigned long long hash);
+    bool mayContainHash(unsigned long long hash);
+
+    void add(Tkey key){addHash(hasher(key));};
+    bool mayContain(Tkey key){return mayContainHash(hasher(key));};
+};
+
+//counting blocked Bloom filter, every lane holds 16 4 bit counters rather than 64 bits, so keys can be removed as well
+//a counter that reaches 15 sticks there, so heavily shared counters can never cause a false negative
+//only remove keys that were added, removing anything else can cause false negatives
+template <typename Tkey, typename Thash = mja_Hash<Tkey>>
+class mja_CountingBloomFilter {
+
+private:
+
+    struct alignas(64) Block {
+        unsigned long long lanes[8]; //16 counters per lane
+    };
+
+    Block* blocks;
+    unsigned long long blockCount;
+    Thash hasher; //hash function object, only used by the key versions of the functions
+
+    //picks a block using the top 32 bits of the hash, multiply and shift avoids needing a power of 2 block count
+    Block& getBlock(unsigned long long hash){
+        return blocks[((hash >> 32) * blockCount) >> 32];
+    };
+
+public:
+
+    //sized for expectedKeys at countersPerKey counters each, 16 counters (8 bytes) per key gives roughly a 0.5% false positive rate
+    mja_CountingBloomFilter(int expectedKeys, int countersPerKey, Thash hasher);
+    mja_CountingBloomFilter(int expectedKeys, int countersPerKey) : mja_CountingBloomFilter(expectedKeys, countersPerKey, Thash()) {};
+    mja_CountingBloomFilter(int expectedKeys) : mja_CountingBloomFilter(expectedKeys, 16, Thash()) {};
+    mja_CountingBloomFilter(mja_CountingBloomFilter<Tkey, Thash> &oldFilter); //copy constructor
+
+    ~mja_CountingBloomFilter(){delete[] blocks;};
+
+    unsigned long long getBlockCount(){return blockCount;};
+    void clear(); //empties the filter
+
+    //hash versions, for callers that already have a 64 bit hash (e.g. one stored by a hash table)
+    void addHash(unsigned long long hash);
+    void remHash(unsigned long long hash);
+    bool mayContainHash(unsigned long long hash);
+
+    void add(Tkey key){addHash(hasher(key));};
+    void rem(Tkey key){remHash(hasher(key));};
+    bool mayContain(Tkey key){return mayContainHash(hasher(key));};
+};
+
+/*
+more lengthy/looping functions are defined below to prevent above main header getting spammed
+*/
+
+//base constructor, 512 bits per block
+template <typename Tkey, typename Thash>
+mja_BloomFilter<Tkey, Thash> :: mja_BloomFilter(int expectedKeys, int bitsPerKey, Thash hasher) : hasher(hasher) {
+    if (expectedKeys < 1){
+        expectedKeys = 1;
+    }
+    if (bitsPerKey < 1){
+        bitsPerKey = 1;
+    }
+    blockCount = ((unsigned long long)expectedKeys * (unsigned long long)bitsPerKey + 511) / 512;
+    blocks = new Block[blockCount];
+    clear();
+};
+
+//copy constructor
+template <typename Tkey, typename Thash>
+mja_BloomFilter<Tkey, Thash> :: mja_BloomFilter(mja_BloomFilter<Tkey, Thash> &oldFilter) : hasher(oldFilter.hasher) {
+    blockCount = oldFilter.blockCount;
+    blocks = new Block[blockCount];
+    for (unsigned long long i=0; i<blockCount; i++){
+        blocks[i] = oldFilter.blocks[i];
+    }
+};
+
+//clears every bit
+template <typename Tkey, typename Thash>
+void mja_BloomFilter<Tkey, Thash> :: clear(){
+    for (unsigned long long i=0; i<blockCount; i++){
+        for (int j=0; j<8; j++){
+            blocks[i].lanes[j] = 0;
+        }
+    }
+};
+
+//sets one bit in each lane of the key's block, the top 6 bits of each salted product pick the bit
+template <typename Tkey, typename Thash>
+void mja_BloomFilter<Tkey, Thash> :: addHash(unsigned long long hash){
+    Block& block = getBlock(hash);
+    unsigned int low = (unsigned int)hash;
+    for (int j=0; j<8; j++){
+        block.lanes[j] |= 1ULL << ((low * MJA_BLOOM_SALTS[j]) >> 26);
+    }
+};
+
+//checks the key's bit in every lane, no early exit so the loop stays branch free
+template <typename Tkey, typename Thash>
+bool mja_BloomFilter<Tkey, Thash> :: mayContainHash(unsigned long long hash){
+    Block& block = getBlock(hash);
+    unsigned int low = (unsigned int)hash;
+    unsigned long long all = 1;
+    for (int j=0; j<8; j++){
+        all &= block.lanes[j] >> ((low * MJA_BLOOM_SALTS[j]) >> 26);
+    }
+    return (all & 1) != 0;
+};
+
+//base constructor, 128 counters per block
+template <typename Tkey, typename Thash>
+mja_CountingBloomFilter<Tkey, Thash> :: mja_CountingBloomFilter(int expectedKeys, int countersPerKey, Thash hasher) : hasher(hasher) {
+    if (expectedKeys < 1){
+        expectedKeys = 1;
+    }
+    if (countersPerKey < 1){
+        countersPerKey = 1;
+    }
+    blockCount = ((unsigned long long)expectedKeys * (unsigned long long)countersPerKey + 127) / 128;
+    blocks = new Block[blockCount];
+    clear();
+};
+
+//copy constructor
+template <typename Tkey, typename Thash>
+mja_CountingBloomFilter<Tkey, Thash> :: mja_CountingBloomFilter(mja_CountingBloomFilter<Tkey, Thash> &oldFilter) : hasher(oldFilter.hasher) {
+    blockCount = oldFilter.blockCount;
+    blocks = new Block[blockCount];
+    for (unsigned long long i=0; i<blockCount; i++){
+        blocks[i] = oldFilter.blocks[i];
+    }
+};
+
+//clears every counter
+template <typename Tkey, typename Thash>
+void mja_CountingBloomFilter<Tkey, Thash> :: clear(){
+    for (unsigned long long i=0; i<blockCount; i++){
+        for (int j=0; j<8; j++){
+            blocks[i].lanes[j] = 0;
+        }
+    }
+};
+
+//increments one counter in each lane of the key's block, the top 4 bits of each salted product pick the counter
+template <typename Tkey, typename Thash>
+void mja_CountingBloomFilter<Tkey, Thash> :: addHash(unsigned long long hash){
+    Block& block = getBlock(hash);
+    unsigned int low = (unsigned int)hash;
+    for (int j=0; j<8; j++){
+        int shift = (int)((low * MJA_BLOOM_SALTS[j]) >> 28) * 4;
+        if (((block.lanes[j] >> shift) & 15) != 15){ //saturated counters stay put
+            block.lanes[j] += 1ULL << shift;
+        }
+    }
+};
+
+//decrements the key's counters, saturated counters are left alone as their true count is unknown
+template <typename Tkey, typename Thash>
+void mja_CountingBloomFilter<Tkey, Thash> :: remHash(unsigned long long hash){
+    Block& block = getBlock(hash);
+    unsigned int low = (unsigned int)hash;
+    for (int j=0; j<8; j++){
+        int shift = (int)((low * MJA_BLOOM_SALTS[j]) >> 28) * 4;
+        unsigned long long count = (block.lanes[j] >> shift) & 15;
+        if (count != 15 && count != 0){
+            block.lanes[j] -= 1ULL << shift;
+        }
+    }
+};
+
+//checks that every one of the key's counters is non zero, no early exit so the loop stays branch free
+template <typename Tkey, typename Thash>
+bool mja_CountingBloomFilter<Tkey, Thash> :: mayContainHash(unsigned long long hash){
+    Block& block = getBlock(hash);
+    unsigned int low = (unsigned int)hash;
+    bool all = true;
+    for (int j=0; j<8; j++){
+        all &= (((block.lanes[j] >> (((low * MJA_BLOOM_SALTS[j]) >> 28) * 4)) & 15) != 0);
+    }
+    return all;
+};
+
+
+#endif
@@ -29,10 +29,28 @@ SOFTWARE.
 
 #include "mja_LinkedList.h"
 #include "mja_HashTable.h"
+#include "mja_FlatHashTable.h" //needed for the per vertex edge index of high degree vertices
+#include "mja_GraphCSR.h"
+#include "mja_mergeSort.h" //needed to put the unique IDs in order when freezing, and edge lists in order when loading
+#include "mja_graphParallel.h" //needed for the parallel batch edge insertion
+#include <cstdio> //needed for saving graphs
+#include <cstring>
+#include <cstdlib> //needed for parsing weights
+#include <climits> //needed for INT_MAX, larger batches are split up
+#include <type_traits> //needed to check stored objects can be saved byte for byte
 
+//map files straight into memory for loading where possible, otherwise fall back to reading them into a buffer
+#if defined(__unix__) || defined(__APPLE__)
+#define MJA_GRAPH_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
+//unique IDs are handed out in order so they already spread evenly over the hash table's power of 2 buckets
 inline int defaultHash(unsigned int key){
-    return (key % (unsigned int)1033);
+    return (int)key;
 }
 
 //keeps all error codes for the adjacency list graph together, allows for both Vertex and Graph classes to use the same codes
@@ -47,7 +65,20 @@ protected:
     const int SAME_SRC_DEST = 3; //source and destination are the same node
     const int NOT_EXIST_EDGE = 4; //edge doesn't exist (failed attempt to remove non-existent edge)
     const int RESET_EDGE = 5; //edge already existed (attempt to add an existing edge, just updates the edges weight)
+    const int FILE_ERROR = 6; //file couldn't be opened, read, written or mapped
+    const int BAD_FORMAT = 7; //file isn't in the expected format (or a saved graph was saved with a different object type)
+    const int NO_FREE_ID = 8; //every unique ID has been handed out, the vertex wasn't added
+
+};
+
+//file formats accepted by mja_GraphAdjList::loadEdgeList
+class mja_ConfigCode_GraphAdjList {
+
+public:
 
+    static const int EDGES_TEXT = 0; //one "src dest" or "src dest weight" per line, lines starting with # or % are comments
+    static const int EDGES_BINARY = 1; //packed pairs of 32 bit unsigned src, dest (native byte order), every weight is 1.0
+    static const int EDGES_BINARY_WEIGHTED = 2; //packed 16 byte records of 32 bit unsigned src, dest then a 64 bit double weight
 };
 
 
@@ -62,9 +93,10 @@ private:
     struct Edge{
         Edge(Vertex* v, double w) {this->v = v; this->w = w;};
         Edge(Vertex* v) : Edge(v, 1.0){}; //1.0 as default weight if 'unweighted' graph
-        ~Edge(){v = nullptr;};
+        ~Edge(){v = nullptr; twin = nullptr;};
         Vertex* v;
         double w;
+        mja_NodeLL<Edge>* twin = nullptr; //when tracking in edges, the matching node in the other vertex's list, so either side can unlink both in O(1)
     }; //END -- STRUCT EDGE
 
     class Vertex : mja_ErrorCode_GraphAdjList {
@@ -75,15 +107,40 @@ private:
     private:
 
         Vertex(T* obj, unsigned int uniqueID){this->obj = obj; this->uniqueID = uniqueID;};
-        ~Vertex(){if (obj != nullptr){delete obj;}};
+        ~Vertex(){if (obj != nullptr){delete obj;} delete edgeIndex;};
+
+        //out degree at which a vertex starts indexing its edges, below it a scan of the list is quicker than hashing
+        //the index is only dropped once the degree falls to a quarter of this, so a vertex sat near it doesn't keep rebuilding
+        //connections holds at most one node per destination and the list owns them, the flat table deletes whatever it's made to
+        //overwrite or rem, so entries are only ever taken out with pop and indexEdge pops any stale entry before adding
+        static const int INDEX_DEGREE = 16;
 
         unsigned int uniqueID;
         T* obj;
         int edgeCount = 0;
         mja_LinkedList<Edge> connections; //edges from this node to other nodes
+        int inEdgeCount = 0;
+        mja_LinkedList<Edge> inConnections; //edges from other nodes to this node, only filled if the graph tracks in edges
+        mja_FlatHashTable<mja_NodeLL<Edge>, unsigned int>* edgeIndex = nullptr; //destination's unique ID to its node in connections, only kept for high degree vertices (safe destruction, the list owns the nodes)
+
+        //points the index at an out edge's node, popping first so an older entry for the destination is never deleted by the add
+        void indexEdge(mja_NodeLL<Edge>* node){
+            edgeIndex->pop(node->obj->v->uniqueID);
+            edgeIndex->add(node, node->obj->v->uniqueID);
+        }
+        //indexes every out edge so finding one no longer needs a scan
+        void buildIndex(){
+            edgeIndex = new mja_FlatHashTable<mja_NodeLL<Edge>, unsigned int>(2 * edgeCount, mja_Hash<unsigned int>(), true);
+            for (mja_NodeLL<Edge>* node = connections.getFirstNode(); node != nullptr; node = node->getNext()){
+                indexEdge(node);
+            }
+        }
 
         //returns the linked list node where the edge between this node (u) and the other node (v) exists
         mja_NodeLL<Edge>* getConnectionNode(Vertex* v){
+            if (edgeIndex != nullptr){
+                return edgeIndex->get(v->uniqueID);
+            }
             if (connections.resetCycleUp()){
                 do {
                     if (connections.cycle->obj->v == v){
@@ -94,18 +151,53 @@ private:
             return nullptr; //edge not found return nullptr
         }
 
-        //add new edge
-        void addEdge(Vertex* v, double w){connections.addEnd(new Edge(v, w));};
+        //add new edge, indexing the edges once the degree gets high enough
+        void addEdge(Vertex* v, double w){
+            connections.addEnd(new Edge(v, w));
+            edgeCount++;
+            if (edgeIndex != nullptr){
+                indexEdge(connections.getLastNode());
+            } else if (edgeCount >= INDEX_DEGREE){
+                buildIndex();
+            }
+        }
         //rem edge if exists
         int remEdge(Vertex* v){
             mja_NodeLL<Edge>* ptr = getConnectionNode(v);
             if (ptr != nullptr) {
-                connections.remNode(ptr);
-                edgeCount--;
+                remEdgeNode(ptr);
                 return SUCCESS; //indicate successful removal of edge
             }
             return NOT_EXIST_EDGE; //indicate that the edge doesn't exist
         }
+        //removes an out edge given its node, along with its twin in the destination's in edges
+        void remEdgeNode(mja_NodeLL<Edge>* ptr){
+            if (ptr->obj->twin != nullptr){
+                ptr->obj->v->inConnections.remNode(ptr->obj->twin);
+                ptr->obj->v->inEdgeCount--;
+            }
+            if (edgeIndex != nullptr){
+                edgeIndex->pop(ptr->obj->v->uniqueID); //pop rather than rem, the node is freed by the list
+            }
+            connections.remNode(ptr);
+            edgeCount--;
+            if (edgeIndex != nullptr && edgeCount <= INDEX_DEGREE/4){
+                delete edgeIndex; //low enough degree to go back to scanning
+                edgeIndex = nullptr;
+            }
+        }
+        //returns the in edges' source keys
+        unsigned int* getInEdges(){
+            if (inEdgeCount == 0){
+                return nullptr; //no in edges stored return a nullptr
+            }
+            unsigned int* output = new unsigned int[inEdgeCount];
+            unsigned int* ptr = output;
+            for (mja_NodeLL<Edge>* node = inConnections.getFirstNode(); node != nullptr; node = node->getNext()){
+                *(ptr++) = node->obj->v->getUniqueID(); //set values of output via post incrementing ptr
+            }
+            return output;
+        }
         //returns edge structure from memory heap
         Edge* getConnection(Vertex* v){
             mja_NodeLL<Edge>* ptr = getConnectionNode(v);
@@ -137,6 +229,98 @@ private:
     mja_HashTable<Vertex, unsigned int> vertices;
     int tableLength;
     int (*tableFunc)(unsigned int);
+    bool trackInEdges; //if true every edge is also stored in its destination's in edges
+
+    //adds a new edge known not to exist yet, keeping the in edges in step if they're tracked
+    void linkEdge(Vertex* srcPtr, Vertex* destPtr, double weight){
+        srcPtr->addEdge(destPtr, weight);
+        if (trackInEdges){
+            destPtr->inConnections.addEnd(new Edge(srcPtr, weight));
+            destPtr->inEdgeCount++;
+            mja_NodeLL<Edge>* outNode = srcPtr->connections.getLastNode();
+            mja_NodeLL<Edge>* inNode = destPtr->inConnections.getLastNode();
+            outNode->obj->twin = inNode;
+            inNode->obj->twin = outNode;
+        }
+    };
+
+    //finds the out edge node from src to dest, through src's edge index if it has one,
+    //otherwise scanning dest's in edges instead when that list is shorter
+    mja_NodeLL<Edge>* getEdgeNode(Vertex* srcPtr, Vertex* destPtr){
+        if (srcPtr->edgeIndex == nullptr && trackInEdges && destPtr->inEdgeCount < srcPtr->edgeCount){
+            for (mja_NodeLL<Edge>* node = destPtr->inConnections.getFirstNode(); node != nullptr; node = node->getNext()){
+                if (node->obj->v == srcPtr){
+                    return node->obj->twin;
+                }
+            }
+            return nullptr;
+        }
+        return srcPtr->getConnectionNode(destPtr);
+    };
+
+    static bool csrSortOp(unsigned int a, unsigned int b){return a > b;}; //ascending order for the sorts
+
+    //one edge of a bulk load
+    struct EdgeRecord {
+        unsigned int src;
+        unsigned int dest;
+        double w;
+    };
+    //ascending by source then destination, equal edges count as already in order so the merge sort keeps them in file order
+    static bool recordSortOp(EdgeRecord a, EdgeRecord b){return (a.src != b.src) ? (a.src > b.src) : (a.dest >= b.dest);};
+
+    //one edge of a batch insert, pos is its index in the caller's arrays
+    struct BatchRecord {
+        unsigned int src;
+        unsigned int dest;
+        long long pos;
+    };
+    //ascending by source, destination then position, so repeats of an edge stay in the caller's order
+    static bool batchSortOp(BatchRecord a, BatchRecord b){
+        if (a.src != b.src){
+            return a.src > b.src;
+        }
+        return (a.dest != b.dest) ? (a.dest > b.dest) : (a.pos > b.pos);
+    };
+    static bool keySortOp(unsigned long long a, unsigned long long b){return a > b;}; //ascending order for the sorts
+    static const int MAX_BATCH = INT_MAX / 2; //largest batch sorted in one go, the merge sort's split point (left + right)/2 must fit in an int
+
+    //on disk header of a saved graph, each array after it starts on a 64 byte boundary
+    struct FileHeader {
+        char magic[8];
+        unsigned int version;
+        unsigned int objSize; //catches files saved with a different object type
+        unsigned int nextID; //unique ID the next added vertex gets
+        unsigned int reserved;
+        unsigned long long vertexCount;
+        unsigned long long edgeCount;
+    };
+    static const unsigned int FILE_VERSION = 1;
+    static void setMagic(char* magic){std::memcpy(magic, "MJAGRAPH", 8);};
+    static unsigned long long alignOffset(unsigned long long offset){return (offset + 63) & ~(unsigned long long)63;};
+
+    static const char* mapFile(const char* path, unsigned long long &size, bool &mapped); //maps (or reads) a whole file in read only, nullptr on failure
+    static void unmapFile(const char* data, unsigned long long size, bool mapped);
+
+    //0xFFFFFFFF is never a vertex's unique ID, so the next ID to hand out (one above the largest in use) can always be stored without wrapping
+    static const unsigned int MAX_ID = 0xFFFFFFFEU;
+
+    //adds a vertex under a given unique ID (which mustn't be in use and can't be above MAX_ID), later vertices get IDs above it
+    Vertex* addVertexWithID(T* obj, unsigned int id){
+        Vertex* v = new Vertex(obj, id);
+        vertices.add(v, id);
+        if (id >= uniqueID){
+            uniqueID = id + 1;
+        }
+        return v;
+    };
+    //finds a vertex, adding it with makeObj's object (or nullptr) if it doesn't exist
+    Vertex* getOrAddVertex(unsigned int id, T* (*makeObj)(unsigned int)){
+        Vertex* v = vertices.get(id);
+        return (v != nullptr) ? v : addVertexWithID((makeObj != nullptr) ? makeObj(id) : nullptr, id);
+    };
+    void linkSortedEdges(const EdgeRecord* records, long long count, T* (*makeObj)(unsigned int)); //adds edges sorted by source with no repeats
+    void clearVertices(); //removes every vertex and edge
 
     int srcDestCheck(Vertex* srcPtr, Vertex* destPtr){
         if (srcPtr == nullptr){
@@ -153,8 +337,11 @@ private:
 
 public:
 
-    mja_GraphAdjList(int tableLength, int(*tableFunc)(unsigned int)) : vertices(tableLength, tableFunc, false){this->tableLength = tableLength; this->tableFunc = tableFunc;};
-    mja_GraphAdjList() : mja_GraphAdjList(1033, &defaultHash){};
+    //trackInEdges also stores every edge at its destination, doubling edge memory but making remVertex O(in + out degree) and allowing in edge queries
+    mja_GraphAdjList(int tableLength, int(*tableFunc)(unsigned int), bool trackInEdges) : vertices(tableLength, tableFunc, false){this->tableLength = tableLength; this->tableFunc = tableFunc; this->trackInEdges = trackInEdges;};
+    mja_GraphAdjList(int tableLength, int(*tableFunc)(unsigned int)) : mja_GraphAdjList(tableLength, tableFunc, false){};
+    explicit mja_GraphAdjList(bool trackInEdges) : mja_GraphAdjList(1033, &defaultHash, trackInEdges){};
+    mja_GraphAdjList() : mja_GraphAdjList(1033, &defaultHash, false){};
     mja_GraphAdjList(mja_GraphAdjList<T> &oldGraph); //copy constructor
 
     ~mja_GraphAdjList(){};
@@ -163,7 +350,7 @@ public:
     unsigned int* getKeys(){return vertices.getKeys();};
 
     //add a new vertex to the graph
-    int addVertex(T* obj){vertices.add(new Vertex(obj, uniqueID), uniqueID); uniqueID++; return SUCCESS;}; //returns success as uniqueID will always be unique (except for unlikely overflow which will take over 4294967295 nodes to be added)
+    int addVertex(T* obj){if (uniqueID > MAX_ID){return NO_FREE_ID;} vertices.add(new Vertex(obj, uniqueID), uniqueID); uniqueID++; return SUCCESS;}; //uniqueID is always unique, once every ID up to MAX_ID is used up nothing more is added (obj is left with the caller)
     int remVertex(unsigned int key); //remove a vertex from the graph (also remove all edges where the vertex is a destination)
     T* popVertex(unsigned int key); //remove a vertex from the graph while preserving the stored object
 
@@ -173,6 +360,33 @@ public:
 
     int remEdge(unsigned int src, unsigned int dest); //removes an edge from the graph
 
+    //adds (or resets the weight of) n edges, giving the same graph and return codes as calling addEdge on each in order
+    //edges are sorted by source so each source is looked up once and its new edges merged in by a single thread, with sources shared out between threads
+    //w can be nullptr for weights of 1.0, flags (can be nullptr) gets each edge's return code, threadCount of 0 uses every hardware thread
+    void addEdges(const unsigned int* src, const unsigned int* dest, const double* w, size_t n, int* flags, int threadCount);
+    void addEdges(const unsigned int* src, const unsigned int* dest, const double* w, size_t n){addEdges(src, dest, w, n, nullptr, 0);};
+
+    //in edge queries, only available when the graph tracks in edges (otherwise they return -1/nullptr)
+    bool isTrackingInEdges(){return trackInEdges;};
+    int getInEdgeCount(unsigned int key){Vertex* v = vertices.get(key); return (trackInEdges && v != nullptr) ? v->inEdgeCount : -1;};
+    unsigned int* getInEdges(unsigned int key){Vertex* v = vertices.get(key); return (trackInEdges && v != nullptr) ? v->getInEdges() : nullptr;}; //keys of every vertex with an edge to key (caller must delete[])
+
+    //builds an immutable compressed sparse row copy of the graph's structure for fast traversal (caller must delete it)
+    //later changes to this graph aren't reflected in it, stored objects aren't copied
+    mja_GraphCSR* freeze();
+
+    //bulk loads an edge list file (see mja_ConfigCode_GraphAdjList for the formats), the file's vertex IDs are used as unique IDs
+    //vertices that don't exist yet are added with makeObj(id) as their object (nullptr objects if makeObj is nullptr),
+    //edges are sorted so repeats collapse into one edge with the last weight in the file, and edges that already exist are reset
+    //self loops are skipped, ID 0xFFFFFFFF is reserved and makes the file malformed, returns SUCCESS, FILE_ERROR or BAD_FORMAT (nothing is added if the file is malformed)
+    int loadEdgeList(const char* path, int format, T* (*makeObj)(unsigned int));
+    int loadEdgeList(const char* path, int format){return loadEdgeList(path, format, nullptr);};
+
+    //binary save and load of the whole graph, unique IDs are kept and objects are copied byte for byte so T must be trivially copyable
+    //load replaces everything in the graph and keeps its in edge tracking setting, returns SUCCESS, FILE_ERROR or BAD_FORMAT
+    int save(const char* path);
+    int load(const char* path);
+
 };
 
 /*
@@ -181,27 +395,25 @@ more lengthy/looping functions are defined below to prevent above main header ge
 
 //copy constructor
 template <typename T>
-mja_GraphAdjList<T> :: mja_GraphAdjList(mja_GraphAdjList<T> &oldGraph) : mja_GraphAdjList(oldGraph.tableLength, &defaultHash) {
+mja_GraphAdjList<T> :: mja_GraphAdjList(mja_GraphAdjList<T> &oldGraph) : mja_GraphAdjList(oldGraph.tableLength, oldGraph.tableFunc, oldGraph.trackInEdges) {
 
     //copy over each vertex
-    unsigned int* oldKeys = oldGraph.getKeys();
-    for (int i=0; i<oldGraph.getNodeCount();i++){
-        Vertex* v = oldGraph.vertices.get(oldKeys[i]);
-        this->vertices.add(new Vertex(new T(*(v->obj)), oldKeys[i]), oldKeys[i]); //add new node to graph
-    }
-    //copy over all edges
-    for (int i=0;i<oldGraph.getNodeCount();i++){
-        Vertex* u = oldGraph.vertices.get(oldKeys[i]);
-        if (u->getEdgeCount() != 0){
-            unsigned int* edges = u->getEdges(); //should never be a nullptr as getEdgeCount would return 0 if no edges existed
-            for (int j=0;j<u->getEdgeCount();j++){
-                Vertex* v = oldGraph.vertices.get(edges[j]);
-                this->vertices.get(oldKeys[i])->addEdge(this->vertices.get(edges[j]), u->getConnection(v)->w);
+    if (oldGraph.vertices.resetCycle()){
+        do {
+            Vertex* v = oldGraph.vertices.getCycleObj();
+            this->vertices.add(new Vertex((v->obj != nullptr) ? new T(*(v->obj)) : nullptr, v->uniqueID), v->uniqueID); //add new node to graph
+        } while (oldGraph.vertices.cycleNext());
+    }
+    //copy over all edges, walking each vertex's connections directly rather than allocating an array of them
+    if (oldGraph.vertices.resetCycle()){
+        do {
+            Vertex* u = oldGraph.vertices.getCycleObj();
+            Vertex* newU = this->vertices.get(u->uniqueID);
+            for (mja_NodeLL<Edge>* node = u->connections.getFirstNode(); node != nullptr; node = node->getNext()){
+                linkEdge(newU, this->vertices.get(node->obj->v->uniqueID), node->obj->w);
             }
-            delete[] edges;
-        }
+        } while (oldGraph.vertices.cycleNext());
     }
-    delete[] oldKeys;
     this->uniqueID = oldGraph.uniqueID;
 };
 
@@ -211,12 +423,22 @@ int mja_GraphAdjList<T> :: remVertex(unsigned int key){
     //pop vertex from hash table
     Vertex* v = vertices.pop(key);
     if (v != nullptr){ //if v doesn't exist then cant deallocate it
-        //remove all incoming edges to this node
-        unsigned int* nodes = getKeys();
-        for (int i=0; i<getNodeCount();i++){
-            remEdge(nodes[i], key);
+        if (trackInEdges){
+            //each in edge's twin is the source's out edge, and each out edge's twin sits in its destination's in edges
+            while (!v->inConnections.isEmpty()){
+                mja_NodeLL<Edge>* inNode = v->inConnections.getFirstNode();
+                inNode->obj->v->remEdgeNode(inNode->obj->twin); //also unlinks inNode
+            }
+            for (mja_NodeLL<Edge>* node = v->connections.getFirstNode(); node != nullptr; node = node->getNext()){
+                node->obj->v->inConnections.remNode(node->obj->twin);
+                node->obj->v->inEdgeCount--;
+            }
+        //remove all incoming edges to this node, straight from each vertex as v can no longer be looked up by key
+        } else if (vertices.resetCycle()){
+            do {
+                vertices.getCycleObj()->remEdge(v);
+            } while (vertices.cycleNext());
         }
-        delete[] nodes; //deallocate heap memory storing current node keys
         delete v; //deallocate heap memory storing the vertex
         return SUCCESS;
     }
@@ -247,13 +469,15 @@ int mja_GraphAdjList<T> :: addEdge(unsigned int src, unsigned int dest, double w
         return check;
     }
     //both source and destination exist, see if an edge between them exists
-    Edge* edgePtr = srcPtr->getConnection(destPtr);
-    if (edgePtr != nullptr){ //edge exists already
-        edgePtr->w = weight; //update weight
+    mja_NodeLL<Edge>* edgeNode = getEdgeNode(srcPtr, destPtr);
+    if (edgeNode != nullptr){ //edge exists already
+        edgeNode->obj->w = weight; //update weight
+        if (edgeNode->obj->twin != nullptr){
+            edgeNode->obj->twin->obj->w = weight;
+        }
         return RESET_EDGE; //indicate that edge already exists and that the weight has been reset
     }
-    srcPtr->addEdge(destPtr, weight); //edge doesn't exist add a new edge
-    srcPtr->edgeCount++;
+    linkEdge(srcPtr, destPtr, weight); //edge doesn't exist add a new edge
     return SUCCESS; //indicates successful addition of new edge
 };
 
@@ -266,13 +490,596 @@ int mja_GraphAdjList<T> :: remEdge(unsigned int src, unsigned int dest){
     if (check != SUCCESS){ //if failed the src/dest key check
         return check;
     }
-    return srcPtr->remEdge(destPtr); //function returns success/fail depending on if the edge exists or not
+    mja_NodeLL<Edge>* edgeNode = getEdgeNode(srcPtr, destPtr);
+    if (edgeNode != nullptr){
+        srcPtr->remEdgeNode(edgeNode);
+        return SUCCESS;
+    }
+    return NOT_EXIST_EDGE; //indicate that the edge doesn't exist
+};
+
+//sorts the unique IDs to give the dense indices, then lays each vertex's edges out in order
+template <typename T>
+mja_GraphCSR* mja_GraphAdjList<T> :: freeze(){
+    int vertexCount = vertices.getKeyCount();
+    unsigned int* ids = new unsigned int[vertexCount];
+    long long* offsets = new long long[vertexCount + 1];
+    Vertex** ptrs = new Vertex*[vertexCount]; //saves looking every vertex up twice
+    int index = 0;
+    if (vertices.resetCycle()){
+        do {
+            ids[index++] = vertices.getCycleKey();
+        } while (vertices.cycleNext());
+    }
+    mja_mergeSort(ids, 0, vertexCount, csrSortOp);
+
+    offsets[0] = 0;
+    for (int i=0; i<vertexCount; i++){
+        ptrs[i] = vertices.get(ids[i]);
+        offsets[i+1] = offsets[i] + ptrs[i]->edgeCount;
+    }
+    long long edgeCount = offsets[vertexCount];
+    int* targets = new int[edgeCount];
+    double* weights = new double[edgeCount];
+    mja_GraphCSR* output = new mja_GraphCSR(vertexCount, edgeCount, ids, offsets, targets, weights);
+    long long e = 0;
+    for (int i=0; i<vertexCount; i++){
+        for (mja_NodeLL<Edge>* node = ptrs[i]->connections.getFirstNode(); node != nullptr; node = node->getNext()){
+            targets[e] = output->getIndex(node->obj->v->uniqueID);
+            weights[e] = node->obj->w;
+            e++;
+        }
+    }
+    delete[] ptrs;
+    return output;
 };
 
+//maps a file in read only, or reads it into a buffer if mapping isn't available
+template <typename T>
+const char* mja_GraphAdjList<T> :: mapFile(const char* path, unsigned long long &size, bool &mapped){
+    size = 0;
+    mapped = false;
+#ifdef MJA_GRAPH_MMAP
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0){
+        return nullptr;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0){
+        ::close(fd);
+        return nullptr;
+    }
+    if (info.st_size == 0){
+        ::close(fd);
+        static const char empty = 0;
+        return &empty; //can't map an empty file, but it's still a valid (empty) edge list
+    }
+    void* ptr = ::mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); //mapping stays valid after the file is closed
+    if (ptr == MAP_FAILED){
+        return nullptr;
+    }
+    ::madvise(ptr, (size_t)info.st_size, MADV_SEQUENTIAL); //loads stream through the file once
+    size = (unsigned long long)info.st_size;
+    mapped = true;
+    return (const char*)ptr;
+#else
+    FILE* file = std::fopen(path, "rb");
+    if (file == nullptr){
+        return nullptr;
+    }
+    std::fseek(file, 0, SEEK_END);
+    long length = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    if (length < 0){
+        std::fclose(file);
+        return nullptr;
+    }
+    char* buffer = (char*)::operator new((size_t)length + 1); //operator new is aligned enough for the saved arrays
+    if (std::fread(buffer, 1, (size_t)length, file) != (size_t)length){
+        std::fclose(file);
+        ::operator delete(buffer);
+        return nullptr;
+    }
+    std::fclose(file);
+    size = (unsigned long long)length;
+    return buffer;
+#endif
+};
 
+//releases a file from mapFile
+template <typename T>
+void mja_GraphAdjList<T> :: unmapFile(const char* data, unsigned long long size, bool mapped){
+#ifdef MJA_GRAPH_MMAP
+    if (mapped){
+        ::munmap((void*)data, (size_t)size);
+    }
+#else
+    ::operator delete((void*)data);
+#endif
+};
 
+//removes every vertex, their edges all go with them so nothing needs unlinking
+template <typename T>
+void mja_GraphAdjList<T> :: clearVertices(){
+    unsigned int* keys = vertices.getKeys();
+    int count = vertices.getKeyCount();
+    for (int i=0; i<count; i++){
+        delete vertices.pop(keys[i]);
+    }
+    delete[] keys;
+};
 
+//adds sorted, repeat free edges, each source is looked up once and sources that had no edges beforehand skip the duplicate check
+template <typename T>
+void mja_GraphAdjList<T> :: linkSortedEdges(const EdgeRecord* records, long long count, T* (*makeObj)(unsigned int)){
+    long long i = 0;
+    while (i < count){
+        Vertex* srcPtr = getOrAddVertex(records[i].src, makeObj);
+        bool fresh = (srcPtr->edgeCount == 0);
+        unsigned int src = records[i].src;
+        for (; i < count && records[i].src == src; i++){
+            Vertex* destPtr = getOrAddVertex(records[i].dest, makeObj);
+            mja_NodeLL<Edge>* edgeNode = fresh ? nullptr : getEdgeNode(srcPtr, destPtr);
+            if (edgeNode != nullptr){ //edge exists already, reset its weight
+                edgeNode->obj->w = records[i].w;
+                if (edgeNode->obj->twin != nullptr){
+                    edgeNode->obj->twin->obj->w = records[i].w;
+                }
+            } else {
+                linkEdge(srcPtr, destPtr, records[i].w);
+            }
+        }
+    }
+};
 
+//parses the whole file into edge records before touching the graph, then sorts, collapses repeats and adds them source by source
+template <typename T>
+int mja_GraphAdjList<T> :: loadEdgeList(const char* path, int format, T* (*makeObj)(unsigned int)){
+    unsigned long long size;
+    bool mapped;
+    const char* data = mapFile(path, size, mapped);
+    if (data == nullptr){
+        return FILE_ERROR;
+    }
+    EdgeRecord* records = nullptr;
+    long long count = 0;
+    bool valid = true;
+
+    if (format == mja_ConfigCode_GraphAdjList::EDGES_BINARY || format == mja_ConfigCode_GraphAdjList::EDGES_BINARY_WEIGHTED){
+        bool weighted = (format == mja_ConfigCode_GraphAdjList::EDGES_BINARY_WEIGHTED);
+        unsigned long long recordSize = weighted ? 16 : 8;
+        valid = (size % recordSize == 0);
+        if (valid){
+            records = new EdgeRecord[size / recordSize + 1];
+            for (unsigned long long offset = 0; offset < size; offset += recordSize){
+                EdgeRecord record;
+                std::memcpy(&record.src, data + offset, 4);
+                std::memcpy(&record.dest, data + offset + 4, 4);
+                record.w = 1.0;
+                if (weighted){
+                    std::memcpy(&record.w, data + offset + 8, 8);
+                }
+                if (record.src > MAX_ID || record.dest > MAX_ID){
+                    valid = false; //reserved ID
+                    break;
+                }
+                if (record.src != record.dest){
+                    records[count++] = record; //post increment access
+                }
+            }
+        }
+    } else if (format == mja_ConfigCode_GraphAdjList::EDGES_TEXT){
+        long long lines = 1;
+        for (unsigned long long c=0; c<size; c++){
+            lines += (data[c] == '\n');
+        }
+        records = new EdgeRecord[lines];
+        const char* ptr = data;
+        const char* end = data + size;
+        while (valid && ptr < end){
+            const char* lineEnd = (const char*)std::memchr(ptr, '\n', (size_t)(end - ptr));
+            if (lineEnd == nullptr){
+                lineEnd = end;
+            }
+            //split the line into at most 3 whitespace separated fields
+            const char* fields[3];
+            int lengths[3];
+            int fieldCount = 0;
+            const char* c = ptr;
+            while (c < lineEnd){
+                while (c < lineEnd && (*c == ' ' || *c == '\t' || *c == '\r' || *c == ',')){
+                    c++;
+                }
+                if (c == lineEnd){
+                    break;
+                }
+                if (fieldCount == 0 && (*c == '#' || *c == '%')){
+                    break; //comment line
+                }
+                const char* start = c;
+                while (c < lineEnd && *c != ' ' && *c != '\t' && *c != '\r' && *c != ','){
+                    c++;
+                }
+                if (fieldCount == 3){
+                    valid = false; //too many fields
+                    break;
+                }
+                fields[fieldCount] = start;
+                lengths[fieldCount] = (int)(c - start);
+                fieldCount++;
+            }
+            if (valid && fieldCount == 1){
+                valid = false; //source without a destination
+            }
+            if (valid && fieldCount >= 2){
+                EdgeRecord record;
+                unsigned int* ids[2] = {&record.src, &record.dest};
+                for (int f=0; f<2 && valid; f++){
+                    unsigned long long id = 0;
+                    valid = (lengths[f] > 0 && lengths[f] <= 10);
+                    for (int k=0; k<lengths[f] && valid; k++){
+                        valid = (fields[f][k] >= '0' && fields[f][k] <= '9');
+                        id = id * 10 + (unsigned long long)(fields[f][k] - '0');
+                    }
+                    valid = valid && (id <= MAX_ID); //0xFFFFFFFF is reserved
+                    *(ids[f]) = (unsigned int)id;
+                }
+                record.w = 1.0;
+                if (valid && fieldCount == 3){
+                    char buffer[64]; //the mapped file isn't null terminated, so copy the weight out before parsing it
+                    valid = (lengths[2] < 64);
+                    if (valid){
+                        std::memcpy(buffer, fields[2], (size_t)lengths[2]);
+                        buffer[lengths[2]] = '\0';
+                        char* parsed;
+                        record.w = std::strtod(buffer, &parsed);
+                        valid = (parsed == buffer + lengths[2]);
+                    }
+                }
+                if (valid && record.src != record.dest){
+                    records[count++] = record; //post increment access
+                }
+            }
+            ptr = lineEnd + 1;
+        }
+    } else {
+        valid = false; //unknown format
+    }
+    unmapFile(data, size, mapped);
+    if (!valid){
+        delete[] records;
+        return BAD_FORMAT;
+    }
+
+    //sort so repeats sit next to each other, then keep the last of each run
+    //the merge sort works on int indices so huge files go in MAX_BATCH pieces, a later piece just resets the weights of edges an earlier one added
+    for (long long start=0; start<count; start+=MAX_BATCH){
+        EdgeRecord* piece = records + start;
+        int length = (int)((count - start < MAX_BATCH) ? (count - start) : MAX_BATCH);
+        mja_mergeSort(piece, 0, length, recordSortOp);
+        int unique = 0;
+        for (int i=0; i<length; i++){
+            if (i + 1 < length && piece[i+1].src == piece[i].src && piece[i+1].dest == piece[i].dest){
+                continue; //a later copy of this edge follows
+            }
+            piece[unique++] = piece[i]; //post increment access
+        }
+        linkSortedEdges(piece, unique, makeObj);
+    }
+    delete[] records;
+    return SUCCESS;
+};
+
+//writes the header, then the vertex IDs (ascending), degrees, object flags and objects, then every edge's destination and weight grouped by source
+//destinations are saved as positions in the vertex ID array rather than IDs, so loading never has to look a vertex up by ID
+template <typename T>
+int mja_GraphAdjList<T> :: save(const char* path){
+    static_assert(std::is_trivially_copyable<T>::value, "saved graph objects must be trivially copyable");
+    int n = vertices.getKeyCount();
+    unsigned int* ids = new unsigned int[n + 1];
+    int index = 0;
+    if (vertices.resetCycle()){
+        do {
+            ids[index++] = vertices.getCycleKey();
+        } while (vertices.cycleNext());
+    }
+    mja_mergeSort(ids, 0, n, csrSortOp);
+
+    unsigned int* degrees = new unsigned int[n + 1];
+    unsigned char* hasObj = new unsigned char[n + 1];
+    char* objs = new char[(unsigned long long)n * sizeof(T) + 1];
+    std::memset(objs, 0, (unsigned long long)n * sizeof(T) + 1); //zero the missing objects so saves of the same graph are identical
+    Vertex** ptrs = new Vertex*[n + 1];
+    unsigned long long m = 0;
+    for (int i=0; i<n; i++){
+        ptrs[i] = vertices.get(ids[i]);
+        degrees[i] = (unsigned int)ptrs[i]->edgeCount;
+        hasObj[i] = (ptrs[i]->obj != nullptr);
+        if (ptrs[i]->obj != nullptr){
+            std::memcpy(objs + (unsigned long long)i * sizeof(T), (const void*)ptrs[i]->obj, sizeof(T));
+        }
+        m += (unsigned long long)ptrs[i]->edgeCount;
+    }
+    unsigned int* targets = new unsigned int[m + 1];
+    double* weights = new double[m + 1];
+    unsigned long long e = 0;
+    for (int i=0; i<n; i++){
+        for (mja_NodeLL<Edge>* node = ptrs[i]->connections.getFirstNode(); node != nullptr; node = node->getNext()){
+            //binary search for the destination's position
+            unsigned int id = node->obj->v->uniqueID;
+            int left = 0;
+            int right = n;
+            while (left < right){
+                int mid = left + (right - left)/2;
+                if (ids[mid] < id){
+                    left = mid + 1;
+                } else {
+                    right = mid;
+                }
+            }
+            targets[e] = (unsigned int)left;
+            weights[e] = node->obj->w;
+            e++;
+        }
+    }
+    delete[] ptrs;
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(FileHeader));
+    setMagic(header.magic);
+    header.version = FILE_VERSION;
+    header.objSize = sizeof(T);
+    header.nextID = uniqueID;
+    header.vertexCount = n;
+    header.edgeCount = m;
+
+    //every section is padded out to the next 64 byte boundary
+    const void* sections[6] = {ids, degrees, hasObj, objs, targets, weights};
+    unsigned long long sizes[6] = {(unsigned long long)n * 4, (unsigned long long)n * 4, (unsigned long long)n, (unsigned long long)n * sizeof(T), m * 4, m * 8};
+    static const char padding[64] = {0};
+    int flag = SUCCESS;
+    FILE* file = std::fopen(path, "wb");
+    if (file == nullptr){
+        flag = FILE_ERROR;
+    } else {
+        bool ok = (std::fwrite(&header, sizeof(FileHeader), 1, file) == 1);
+        unsigned long long offset = sizeof(FileHeader);
+        for (int s=0; s<6 && ok; s++){
+            unsigned long long gap = alignOffset(offset) - offset;
+            ok = (std::fwrite(padding, 1, gap, file) == gap);
+            ok = ok && (sizes[s] == 0 || std::fwrite(sections[s], 1, sizes[s], file) == sizes[s]);
+            offset = alignOffset(offset) + sizes[s];
+        }
+        ok = (std::fclose(file) == 0) && ok;
+        if (!ok){
+            flag = FILE_ERROR;
+        }
+    }
+    delete[] ids;
+    delete[] degrees;
+    delete[] hasObj;
+    delete[] objs;
+    delete[] targets;
+    delete[] weights;
+    return flag;
+};
+
+//checks the whole file before clearing the graph, then adds the vertices in saved order and links each one's edges straight on (a saved graph has no repeats)
+template <typename T>
+int mja_GraphAdjList<T> :: load(const char* path){
+    static_assert(std::is_trivially_copyable<T>::value, "saved graph objects must be trivially copyable");
+    unsigned long long size;
+    bool mapped;
+    const char* data = mapFile(path, size, mapped);
+    if (data == nullptr){
+        return FILE_ERROR;
+    }
+    FileHeader header;
+    char magic[8];
+    setMagic(magic);
+    bool valid = (size >= sizeof(FileHeader));
+    if (valid){
+        std::memcpy(&header, data, sizeof(FileHeader));
+        valid = (std::memcmp(header.magic, magic, 8) == 0) && header.version == FILE_VERSION && header.objSize == sizeof(T);
+        valid = valid && header.vertexCount <= 0x7FFFFFFFULL && header.edgeCount <= (size / 12); //bounds the sizes before they're multiplied up
+    }
+    unsigned long long n = valid ? header.vertexCount : 0;
+    unsigned long long m = valid ? header.edgeCount : 0;
+    unsigned long long sizes[6] = {n * 4, n * 4, n, n * sizeof(T), m * 4, m * 8};
+    unsigned long long offsets[6];
+    unsigned long long offset = sizeof(FileHeader);
+    for (int s=0; s<6; s++){
+        offsets[s] = alignOffset(offset);
+        offset = offsets[s] + sizes[s];
+    }
+    valid = valid && (offset <= size);
+    const unsigned int* ids = (const unsigned int*)(data + offsets[0]);
+    const unsigned int* degrees = (const unsigned int*)(data + offsets[1]);
+    const unsigned char* hasObj = (const unsigned char*)(data + offsets[2]);
+    const char* objs = data + offsets[3];
+    const unsigned int* targets = (const unsigned int*)(data + offsets[4]);
+    const double* weights = (const double*)(data + offsets[5]);
+    if (valid){ //degrees must add up to the edge count and every destination must be a saved vertex, so nothing can be overrun
+        unsigned long long total = 0;
+        for (unsigned long long i=0; i<n; i++){
+            total += degrees[i];
+        }
+        valid = (total == m);
+        for (unsigned long long e=0; e<m && valid; e++){
+            valid = (targets[e] < n);
+        }
+        //no destination can repeat within a vertex's edges, each is stamped with the row (+1) it was last seen in
+        unsigned int* lastRow = new unsigned int[n + 1];
+        for (unsigned long long i=0; i<n; i++){
+            lastRow[i] = 0;
+        }
+        unsigned long long e = 0;
+        for (unsigned long long i=0; i<n && valid; i++){
+            for (unsigned int k=0; k<degrees[i] && valid; k++, e++){
+                valid = (lastRow[targets[e]] != (unsigned int)(i + 1));
+                lastRow[targets[e]] = (unsigned int)(i + 1);
+            }
+        }
+        delete[] lastRow;
+        for (unsigned long long i=1; i<n && valid; i++){
+            valid = (ids[i-1] < ids[i]); //ascending, so no ID repeats
+        }
+        valid = valid && (n == 0 || ids[n-1] <= MAX_ID) && header.nextID <= MAX_ID + 1; //reserved ID, and the next ID can't have wrapped
+    }
+    if (!valid){
+        unmapFile(data, size, mapped);
+        return BAD_FORMAT;
+    }
+
+    clearVertices();
+    uniqueID = 0;
+    Vertex** ptrs = new Vertex*[n + 1];
+    for (unsigned long long i=0; i<n; i++){
+        T* obj = nullptr;
+        if (hasObj[i]){
+            obj = new T(*(const T*)(objs + i * sizeof(T)));
+        }
+        ptrs[i] = addVertexWithID(obj, ids[i]);
+    }
+    unsigned long long e = 0;
+    for (unsigned long long i=0; i<n; i++){
+        for (unsigned int k=0; k<degrees[i]; k++, e++){
+            if (targets[e] != i){ //only a corrupted file could hold a self loop, skip rather than break the graph
+                linkEdge(ptrs[i], ptrs[targets[e]], weights[e]);
+            }
+        }
+    }
+    delete[] ptrs;
+    if (header.nextID > uniqueID){
+        uniqueID = header.nextID; //IDs of removed vertices are never handed out again
+    }
+    unmapFile(data, size, mapped);
+    return SUCCESS;
+};
+
+//batch insert in three steps, vertices are resolved on the calling thread (hash table lookups reorder their buckets so can't run concurrently),
+//then threads each take whole source runs and merge them into those sources' out edges, which no other thread touches,
+//then if in edges are tracked the new edges are regrouped by destination and threads each take whole destination runs
+template <typename T>
+void mja_GraphAdjList<T> :: addEdges(const unsigned int* src, const unsigned int* dest, const double* w, size_t n, int* flags, int threadCount){
+    if (n == 0){
+        return;
+    }
+    if (n > (size_t)MAX_BATCH){ //the merge sort works on int indices, so huge batches go in pieces, each piece sees the edges added by the ones before it
+        for (size_t start=0; start<n; start+=(size_t)MAX_BATCH){
+            size_t length = (n - start < (size_t)MAX_BATCH) ? (n - start) : (size_t)MAX_BATCH;
+            addEdges(src + start, dest + start, (w == nullptr) ? nullptr : w + start, length, (flags == nullptr) ? nullptr : flags + start, threadCount);
+        }
+        return;
+    }
+    int count = (int)n;
+    BatchRecord* records = new BatchRecord[count];
+    for (int i=0; i<count; i++){
+        records[i].src = src[i];
+        records[i].dest = dest[i];
+        records[i].pos = i;
+    }
+    mja_mergeSort(records, 0, count, batchSortOp);
+
+    //look every endpoint up, sources once per run
+    unsigned int* keys = new unsigned int[count];
+    Vertex** srcPtrs = new Vertex*[count];
+    Vertex** destPtrs = new Vertex*[count];
+    int* runStarts = new int[count + 1]; //record index each source run starts at
+    int runCount = 0;
+    for (int i=0; i<count; i++){
+        if (i == 0 || records[i].src != records[i-1].src){
+            keys[runCount] = records[i].src;
+            runStarts[runCount++] = i; //post increment access
+        }
+    }
+    runStarts[runCount] = count;
+    Vertex** runPtrs = new Vertex*[runCount];
+    vertices.getBatch(keys, runCount, runPtrs);
+    for (int r=0; r<runCount; r++){
+        for (int i=runStarts[r]; i<runStarts[r+1]; i++){
+            srcPtrs[i] = runPtrs[r];
+        }
+    }
+    delete[] runPtrs;
+    for (int i=0; i<count; i++){
+        keys[i] = records[i].dest;
+    }
+    vertices.getBatch(keys, count, destPtrs);
+    delete[] keys;
+
+    //merge each source's edges, only the first copy of an edge can be new and the last copy's weight is what's left
+    mja_NodeLL<Edge>** newNodes = new mja_NodeLL<Edge>*[count]; //out edge node each new edge got, for linking its twin
+    threadCount = mja_resolveThreadCount(threadCount);
+    auto mergeRuns = [&](int begin, int end, int){
+        for (int r=begin; r<end; r++){
+            for (int i=runStarts[r]; i<runStarts[r+1]; i++){
+                newNodes[i] = nullptr;
+                int check = srcDestCheck(srcPtrs[i], destPtrs[i]);
+                double weight = (w != nullptr) ? w[records[i].pos] : 1.0;
+                if (check == SUCCESS){
+                    mja_NodeLL<Edge>* edgeNode = srcPtrs[i]->getConnectionNode(destPtrs[i]); //only touches the source's own list
+                    if (edgeNode != nullptr){
+                        edgeNode->obj->w = weight;
+                        if (edgeNode->obj->twin != nullptr){
+                            edgeNode->obj->twin->obj->w = weight; //each twin belongs to exactly one out edge, so no other thread writes it
+                        }
+                        check = RESET_EDGE;
+                    } else {
+                        srcPtrs[i]->addEdge(destPtrs[i], weight);
+                        newNodes[i] = srcPtrs[i]->connections.getLastNode();
+                    }
+                }
+                if (flags != nullptr){
+                    flags[records[i].pos] = check;
+                }
+            }
+        }
+    };
+    mja_parallelChunks(runCount, 64, (runCount > 64) ? threadCount : 1, mergeRuns);
+
+    //link the new edges into their destinations' in edges, grouped by destination so each list has a single writer
+    if (trackInEdges){
+        unsigned long long* order = new unsigned long long[count]; //(destination, record index) pairs
+        int newCount = 0;
+        for (int i=0; i<count; i++){
+            if (newNodes[i] != nullptr){
+                order[newCount++] = ((unsigned long long)records[i].dest << 32) | (unsigned long long)(unsigned int)i; //post increment access
+            }
+        }
+        mja_mergeSort(order, 0, newCount, keySortOp);
+        int* destStarts = new int[newCount + 1];
+        int destCount = 0;
+        for (int k=0; k<newCount; k++){
+            if (k == 0 || (order[k] >> 32) != (order[k-1] >> 32)){
+                destStarts[destCount++] = k; //post increment access
+            }
+        }
+        destStarts[destCount] = newCount;
+        auto linkRuns = [&](int begin, int end, int){
+            for (int r=begin; r<end; r++){
+                for (int k=destStarts[r]; k<destStarts[r+1]; k++){
+                    int i = (int)(order[k] & 0xFFFFFFFFULL);
+                    Vertex* destPtr = destPtrs[i];
+                    destPtr->inConnections.addEnd(new Edge(srcPtrs[i], newNodes[i]->obj->w));
+                    destPtr->inEdgeCount++;
+                    mja_NodeLL<Edge>* inNode = destPtr->inConnections.getLastNode();
+                    newNodes[i]->obj->twin = inNode;
+                    inNode->obj->twin = newNodes[i];
+                }
+            }
+        };
+        mja_parallelChunks(destCount, 64, (destCount > 64) ? threadCount : 1, linkRuns);
+        delete[] order;
+        delete[] destStarts;
+    }
+    delete[] records;
+    delete[] srcPtrs;
+    delete[] destPtrs;
+    delete[] runStarts;
+    delete[] newNodes;
+};
 
 
 #endif
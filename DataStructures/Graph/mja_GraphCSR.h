@@ -0,0 +1,194 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_GRAPHCSR_H
+#define MJA_GRAPHCSR_H
+
+#include "mja_mergeSort.h" //needed to index unique IDs that aren't in order
+
+//immutable graph in compressed sparse row form, made by mja_GraphAdjList::freeze()
+//vertices are renumbered to dense indices 0 to vertexCount-1 (in order of their unique IDs, unless the graph has been reordered, see mja_reorder),
+//the out edges of vertex i are targets[offsets[i]] to targets[offsets[i+1]-1] with matching weights, so walking edges is a linear scan
+class mja_GraphCSR {
+
+private:
+
+    int vertexCount;
+    long long edgeCount;
+    unsigned int* ids; //ids[i] is the unique ID of vertex i, usually sorted ascending so an ID can be binary searched back to its index
+    long long* offsets; //vertexCount + 1 entries
+    int* targets; //dense index of each edge's destination
+    double* weights;
+    int* idOrder = nullptr; //only when ids aren't ascending, the vertex indices in ascending ID order so IDs can still be binary searched
+
+    static bool idSortOp(unsigned long long a, unsigned long long b){return a > b;}; //ascending order for the sort
+    void indexIDs(); //builds idOrder if the IDs aren't already ascending
+
+public:
+
+    //takes ownership of the given arrays (allocated with new[]), ids must be unique, if they aren't ascending they're sorted into a separate lookup
+    mja_GraphCSR(int vertexCount, long long edgeCount, unsigned int* ids, long long* offsets, int* targets, double* weights){
+        this->vertexCount = vertexCount;
+        this->edgeCount = edgeCount;
+        this->ids = ids;
+        this->offsets = offsets;
+        this->targets = targets;
+        this->weights = weights;
+        indexIDs();
+    };
+    mja_GraphCSR(mja_GraphCSR &oldGraph); //copy constructor
+
+    ~mja_GraphCSR(){
+        delete[] ids;
+        delete[] offsets;
+        delete[] targets;
+        delete[] weights;
+        delete[] idOrder;
+    };
+
+    int getVertexCount(){return vertexCount;};
+    long long getEdgeCount(){return edgeCount;};
+
+    //raw arrays for algorithms to stream over, owned by the graph
+    const unsigned int* getIDs(){return ids;};
+    const long long* getOffsets(){return offsets;};
+    const int* getTargets(){return targets;};
+    const double* getWeights(){return weights;};
+
+    unsigned int getID(int index){return ids[index];};
+    int getIndex(unsigned int uniqueID); //dense index of a unique ID, -1 if the graph doesn't have it
+    int getDegree(int index){return (int)(offsets[index+1] - offsets[index]);};
+
+    mja_GraphCSR* transpose(); //returns a new graph with every edge reversed and the same vertex indices (caller must delete it), rows of the transpose list sources in ascending order
+};
+
+/*
+more lengthy/looping functions are defined below to prevent above main header getting spammed
+*/
+
+//copy constructor
+inline mja_GraphCSR :: mja_GraphCSR(mja_GraphCSR &oldGraph){
+    vertexCount = oldGraph.vertexCount;
+    edgeCount = oldGraph.edgeCount;
+    ids = new unsigned int[vertexCount];
+    offsets = new long long[vertexCount + 1];
+    targets = new int[edgeCount];
+    weights = new double[edgeCount];
+    for (int i=0; i<vertexCount; i++){
+        ids[i] = oldGraph.ids[i];
+    }
+    for (int i=0; i<=vertexCount; i++){
+        offsets[i] = oldGraph.offsets[i];
+    }
+    for (long long e=0; e<edgeCount; e++){
+        targets[e] = oldGraph.targets[e];
+        weights[e] = oldGraph.weights[e];
+    }
+    if (oldGraph.idOrder != nullptr){
+        idOrder = new int[vertexCount];
+        for (int i=0; i<vertexCount; i++){
+            idOrder[i] = oldGraph.idOrder[i];
+        }
+    }
+};
+
+//sorts (ID, index) pairs packed into 64 bits when the IDs are out of order, leaving idOrder as nullptr when they're already ascending
+inline void mja_GraphCSR :: indexIDs(){
+    bool ascending = true;
+    for (int i=1; i<vertexCount && ascending; i++){
+        ascending = (ids[i-1] < ids[i]);
+    }
+    if (ascending){
+        return;
+    }
+    unsigned long long* pairs = new unsigned long long[vertexCount];
+    for (int i=0; i<vertexCount; i++){
+        pairs[i] = ((unsigned long long)ids[i] << 32) | (unsigned long long)(unsigned int)i;
+    }
+    mja_mergeSort(pairs, 0, vertexCount, idSortOp);
+    idOrder = new int[vertexCount];
+    for (int i=0; i<vertexCount; i++){
+        idOrder[i] = (int)(pairs[i] & 0xFFFFFFFFULL);
+    }
+    delete[] pairs;
+};
+
+//binary search over the sorted unique IDs, going through idOrder if the IDs themselves aren't in order
+inline int mja_GraphCSR :: getIndex(unsigned int uniqueID){
+    int left = 0;
+    int right = vertexCount; //exclusive
+    while (left < right){
+        int mid = left + (right - left)/2;
+        if (ids[(idOrder != nullptr) ? idOrder[mid] : mid] < uniqueID){
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    if (left < vertexCount){
+        int index = (idOrder != nullptr) ? idOrder[left] : left;
+        if (ids[index] == uniqueID){
+            return index;
+        }
+    }
+    return -1; //unique ID not in the graph
+};
+
+//counting sort of the edges by destination, sources are visited in order so each row of the transpose comes out sorted
+inline mja_GraphCSR* mja_GraphCSR :: transpose(){
+    unsigned int* newIDs = new unsigned int[vertexCount];
+    long long* newOffsets = new long long[vertexCount + 1];
+    int* newTargets = new int[edgeCount];
+    double* newWeights = new double[edgeCount];
+    for (int i=0; i<vertexCount; i++){
+        newIDs[i] = ids[i];
+    }
+    for (int i=0; i<=vertexCount; i++){
+        newOffsets[i] = 0;
+    }
+    for (long long e=0; e<edgeCount; e++){
+        newOffsets[targets[e] + 1]++; //count in degrees
+    }
+    for (int i=0; i<vertexCount; i++){
+        newOffsets[i+1] += newOffsets[i];
+    }
+    long long* fill = new long long[vertexCount];
+    for (int i=0; i<vertexCount; i++){
+        fill[i] = newOffsets[i];
+    }
+    for (int u=0; u<vertexCount; u++){
+        for (long long e=offsets[u]; e<offsets[u+1]; e++){
+            long long slot = fill[targets[e]]++; //post increment access
+            newTargets[slot] = u;
+            newWeights[slot] = weights[e];
+        }
+    }
+    delete[] fill;
+    return new mja_GraphCSR(vertexCount, edgeCount, newIDs, newOffsets, newTargets, newWeights);
+};
+
+
+#endif
@@ -0,0 +1,162 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_CONCURRENTHASHTABLE_H
+#define MJA_CONCURRENTHASHTABLE_H
+
+#include "mja_HashTable.h"
+#include <shared_mutex> //needed for the per shard reader-writer locks
+#include <mutex>
+#include <thread> //needed for the default shard count
+
+//thread safe hash table, keys are split between shards that each have their own chained hash table and reader-writer lock
+//readers on any shard run side by side, writers only block the one shard they touch
+template<typename Tobj, typename Tkey, typename Thash = mja_Hash<Tkey>>
+class mja_ConcurrentHashTable : mja_ErrorCode_HashTable {
+
+private:
+
+    //each shard sits on its own cache line so threads working on neighbouring shards don't fight over the locks
+    struct alignas(64) Shard {
+        std::shared_mutex lock;
+        mja_HashTable<Tobj, Tkey, Thash>* table = nullptr;
+    };
+
+    Shard* shards;
+    int shardCount; //always a power of 2
+    Thash hasher; //hash function object, shared with every shard's table
+
+    //picks a shard using the top bits of the hash, the shard's own table uses the low bits for its buckets
+    Shard& getShard(Tkey key){
+        return shards[(int)((hasher(key) >> 40) & (unsigned long long)(shardCount - 1))];
+    };
+
+public:
+
+    //shardCount of 0 uses 4 shards per hardware thread, length is the starting size of each shard's table
+    mja_ConcurrentHashTable(int shardCount, int length, Thash hasher, bool safeDestruction);
+    mja_ConcurrentHashTable(int length, Thash hasher) : mja_ConcurrentHashTable(0, length, hasher, false) {}; //default setting is to destruct all stored items on exit
+    mja_ConcurrentHashTable(int length) : mja_ConcurrentHashTable(0, length, Thash(), false) {}; //default hasher
+    mja_ConcurrentHashTable(mja_ConcurrentHashTable<Tobj, Tkey, Thash> &oldTable) = delete; //locks can't be copied, copy the shards under a lock instead
+
+    ~mja_ConcurrentHashTable(){
+        for (int i=0; i<shardCount; i++){
+            delete shards[i].table;
+        }
+        delete[] shards;
+    };
+
+    int getShardCount(){return shardCount;};
+    int getKeyCount(); //total across all shards, only a snapshot if other threads are writing
+    Tkey* getKeys(); //returns all the stored keys, holds every shard's read lock so the keys are a consistent snapshot
+
+    //returns a pointer to a stored object, it's only safe to use while no other thread can rem/overwrite that key, use at your own risk!
+    Tobj* get(Tkey key){Shard& s = getShard(key); std::shared_lock<std::shared_mutex> guard(s.lock); return s.table->get(key);};
+    //copies the stored object out while holding the shard's read lock, safe even when other threads are writing
+    int getCopy(Tkey key, Tobj &output);
+
+    int add(Tobj* obj, Tkey key){Shard& s = getShard(key); std::unique_lock<std::shared_mutex> guard(s.lock); return s.table->add(obj, key);};
+    int rem(Tkey key){Shard& s = getShard(key); std::unique_lock<std::shared_mutex> guard(s.lock); return s.table->rem(key);};
+    Tobj* pop(Tkey key){Shard& s = getShard(key); std::unique_lock<std::shared_mutex> guard(s.lock); return s.table->pop(key);};
+};
+
+/*
+more lengthy/looping functions are defined below to prevent above main header getting spammed
+*/
+
+//base constructor
+template <typename Tobj, typename Tkey, typename Thash>
+mja_ConcurrentHashTable<Tobj, Tkey, Thash> :: mja_ConcurrentHashTable(int shardCount, int length, Thash hasher, bool safeDestruction) : hasher(hasher) {
+    if (shardCount <= 0){
+        shardCount = 4 * (int)std::thread::hardware_concurrency();
+    }
+    this->shardCount = 1;
+    while (this->shardCount < shardCount){
+        this->shardCount *= 2; //round up to a power of 2 so the shard can be masked out of the hash
+    }
+    this->shards = new Shard[this->shardCount];
+    for (int i=0; i<this->shardCount; i++){
+        shards[i].table = new mja_HashTable<Tobj, Tkey, Thash>(length, hasher, safeDestruction);
+    }
+};
+
+//sums up the key count of every shard
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_ConcurrentHashTable<Tobj, Tkey, Thash> :: getKeyCount(){
+    int output = 0;
+    for (int i=0; i<shardCount; i++){
+        std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+        output += shards[i].table->getKeyCount();
+    }
+    return output;
+};
+
+//returns all the stored keys, shards are always locked in index order so two snapshots can't deadlock
+template <typename Tobj, typename Tkey, typename Thash>
+Tkey* mja_ConcurrentHashTable<Tobj, Tkey, Thash> :: getKeys(){
+    for (int i=0; i<shardCount; i++){
+        shards[i].lock.lock_shared();
+    }
+    int keyCount = 0;
+    for (int i=0; i<shardCount; i++){
+        keyCount += shards[i].table->getKeyCount();
+    }
+    Tkey* output = nullptr;
+    if (keyCount != 0){
+        output = new Tkey[keyCount];
+        Tkey* shift = output;
+        for (int i=0; i<shardCount; i++){
+            int count = shards[i].table->getKeyCount();
+            if (count != 0){
+                Tkey* keys = shards[i].table->getKeys();
+                for (int j=0; j<count; j++){
+                    *(shift++) = keys[j]; //post increment access
+                }
+                delete[] keys;
+            }
+        }
+    }
+    for (int i=0; i<shardCount; i++){
+        shards[i].lock.unlock_shared();
+    }
+    return output; //nullptr if no keys are stored, same as the single threaded table
+};
+
+//copies out a stored object while the shard is read locked
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_ConcurrentHashTable<Tobj, Tkey, Thash> :: getCopy(Tkey key, Tobj &output){
+    Shard& s = getShard(key);
+    std::shared_lock<std::shared_mutex> guard(s.lock);
+    Tobj* obj = s.table->get(key);
+    if (obj != nullptr){
+        output = *obj;
+        return SUCCESS;
+    }
+    return NON_EXIST_KEY; //indicate that item wasn't found
+};
+
+
+#endif
@@ -0,0 +1,340 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_FLATHASHTABLE_H
+#define MJA_FLATHASHTABLE_H
+
+#include "mja_HashTable.h" //shares the hash table error codes
+#include <new> //needed for placement new, keys are constructed in place inside of the slot array
+#include <utility> //needed for std::move
+
+//use SSE2 to probe a whole group of control bytes at once when it's available, otherwise fall back to a scalar loop
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MJA_FLATHASHTABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+//open addressing hash table (Swiss table style), keys and object pointers are stored inline in a flat slot array
+//each slot has a control byte holding 7 bits of its hash, so a lookup checks 16 slots at a time before touching any keys
+template<typename Tobj, typename Tkey, typename Thash = mja_Hash<Tkey>>
+class mja_FlatHashTable : mja_ErrorCode_HashTable {
+
+private:
+
+    //control byte values, full slots store the low 7 bits of their hash (0 to 127) so have the top bit clear
+    static const signed char EMPTY = -128;
+    static const signed char DELETED = -2;
+    static const int GROUP_SIZE = 16; //slots probed together
+    static const int MAX_CAPACITY = 1 << 30; //largest power of 2 an int holds, the table stops growing here
+
+    struct Slot {
+        Tkey key;
+        Tobj* obj;
+    };
+
+    signed char* ctrl; //control bytes, one per slot
+    Slot* slots; //slot storage, only slots with a full control byte hold a constructed key
+    int capacity; //number of slots, always a power of 2 and a multiple of GROUP_SIZE
+    int keyCount = 0;
+    int deletedCount = 0; //tombstones left by removals, count towards the load as they still lengthen probes
+    bool safeDestruction; //if true then stored items are not destroyed when the table is destroyed
+    Thash hasher; //hash function object, its 64 bit output is well mixed so both the group index and the 7 control bits are spread
+
+    static signed char ctrlHash(unsigned long long h){return (signed char)(h & 0x7F);}; //H2, stored in the control byte
+    int groupIndex(unsigned long long h){return (int)((h >> 7) & (unsigned long long)(capacity/GROUP_SIZE - 1));}; //H1, starting group
+
+    //returns a bit mask of the slots in the group whose control byte matches
+    static unsigned int matchGroup(const signed char* group, signed char value){
+    #ifdef MJA_FLATHASHTABLE_SSE2
+        __m128i bytes = _mm_loadu_si128((const __m128i*)group);
+        return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value)));
+    #else
+        unsigned int mask = 0;
+        for (int i=0; i<GROUP_SIZE; i++){
+            if (group[i] == value){
+                mask |= (1u << i);
+            }
+        }
+        return mask;
+    #endif
+    };
+    //returns a bit mask of the slots in the group that are free to use (empty or deleted both have the top bit set)
+    static unsigned int matchFree(const signed char* group){
+    #ifdef MJA_FLATHASHTABLE_SSE2
+        return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+    #else
+        unsigned int mask = 0;
+        for (int i=0; i<GROUP_SIZE; i++){
+            if (group[i] < 0){
+                mask |= (1u << i);
+            }
+        }
+        return mask;
+    #endif
+    };
+    static int lowestBit(unsigned int mask){
+        int i = 0;
+        while ((mask & 1u) == 0){
+            mask >>= 1;
+            i++;
+        }
+        return i;
+    };
+
+    int findSlot(Tkey key, unsigned long long h); //returns the slot index holding the key, or -1 if it isn't stored
+    int findFree(unsigned long long h); //returns the first free slot along the key's probe sequence
+    void rehash(int newCapacity); //moves all entries into a fresh slot array
+    void clearSlot(int i); //marks a slot as no longer holding an entry, destroying the key
+    void allocate(int newCapacity);
+    static int roundCapacity(int length); //rounds a requested length up to a valid capacity
+
+public:
+
+    //base constructor, length is the starting number of slots (rounded up to a power of 2), the table grows as it fills
+    mja_FlatHashTable(int length, Thash hasher, bool safeDestruction) : hasher(hasher) {
+        this->safeDestruction = safeDestruction;
+        allocate(roundCapacity(length));
+    };
+    mja_FlatHashTable(int length, Thash hasher) : mja_FlatHashTable(length, hasher, false) {}; //default setting is to destruct all stored items on exit
+    mja_FlatHashTable(int length) : mja_FlatHashTable(length, Thash(), false) {}; //default hasher
+    mja_FlatHashTable(mja_FlatHashTable<Tobj, Tkey, Thash> &oldTable); //copy constructor
+
+    ~mja_FlatHashTable(){
+        for (int i=0; i<capacity; i++){
+            if (ctrl[i] >= 0){
+                if (!safeDestruction && slots[i].obj != nullptr){
+                    delete slots[i].obj;
+                }
+                slots[i].key.~Tkey();
+            }
+        }
+        delete[] ctrl;
+        ::operator delete(slots);
+    };
+
+    int getKeyCount(){return keyCount;};
+    Tkey* getKeys(); //returns all the stored keys
+
+    Tobj* get(Tkey key){int i = findSlot(key, hasher(key)); return (i >= 0) ? slots[i].obj : nullptr;}; //get an object stored with a given key
+
+    int add(Tobj* obj, Tkey key); //adds object to that key, if the key already exists then the old object is overwritten (TABLE_FULL if there's no room left, obj stays with the caller)
+    int rem(Tkey key);
+    Tobj* pop(Tkey key);
+};
+
+/*
+more lengthy/looping functions are defined below to prevent above main header getting spammed
+*/
+
+//copy constructor, copies the slot layout directly so nothing needs rehashing
+template <typename Tobj, typename Tkey, typename Thash>
+mja_FlatHashTable<Tobj, Tkey, Thash> :: mja_FlatHashTable(mja_FlatHashTable<Tobj, Tkey, Thash> &oldTable) : hasher(oldTable.hasher) {
+    this->safeDestruction = oldTable.safeDestruction;
+    allocate(oldTable.capacity);
+    for (int i=0; i<capacity; i++){
+        ctrl[i] = oldTable.ctrl[i];
+        if (ctrl[i] >= 0){
+            new (&(slots[i].key)) Tkey(oldTable.slots[i].key);
+            slots[i].obj = new Tobj(*(oldTable.slots[i].obj));
+        }
+    }
+    this->keyCount = oldTable.keyCount;
+    this->deletedCount = oldTable.deletedCount;
+};
+
+//rounds a requested length up to a power of 2 that's at least one group, capped at MAX_CAPACITY
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_FlatHashTable<Tobj, Tkey, Thash> :: roundCapacity(int length){
+    int output = GROUP_SIZE;
+    while (output < length && output < MAX_CAPACITY){
+        output *= 2;
+    }
+    return output;
+};
+
+//allocates empty control bytes and raw slot memory
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_FlatHashTable<Tobj, Tkey, Thash> :: allocate(int newCapacity){
+    capacity = newCapacity;
+    ctrl = new signed char[capacity];
+    for (int i=0; i<capacity; i++){
+        ctrl[i] = EMPTY;
+    }
+    slots = static_cast<Slot*>(::operator new(sizeof(Slot) * capacity)); //raw memory so keys don't need a default constructor
+};
+
+//probes group by group (triangular steps, so every group is visited) until the key or an empty slot is found
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_FlatHashTable<Tobj, Tkey, Thash> :: findSlot(Tkey key, unsigned long long h){
+    signed char tag = ctrlHash(h);
+    int groupMask = capacity/GROUP_SIZE - 1;
+    int group = groupIndex(h);
+    for (int step = 1; step <= groupMask + 1; step++){
+        signed char* groupCtrl = &(ctrl[group * GROUP_SIZE]);
+        unsigned int mask = matchGroup(groupCtrl, tag);
+        while (mask != 0){
+            int i = group * GROUP_SIZE + lowestBit(mask);
+            if (slots[i].key == key){
+                return i;
+            }
+            mask &= mask - 1; //clear lowest set bit
+        }
+        if (matchGroup(groupCtrl, EMPTY) != 0){
+            return -1; //an empty slot ends the probe sequence, so the key isn't stored
+        }
+        group = (group + step) & groupMask;
+    }
+    return -1; //every group checked
+};
+
+//finds the first empty or deleted slot along the probe sequence
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_FlatHashTable<Tobj, Tkey, Thash> :: findFree(unsigned long long h){
+    int groupMask = capacity/GROUP_SIZE - 1;
+    int group = groupIndex(h);
+    for (int step = 1; ; step++){
+        unsigned int mask = matchFree(&(ctrl[group * GROUP_SIZE]));
+        if (mask != 0){
+            return group * GROUP_SIZE + lowestBit(mask);
+        }
+        group = (group + step) & groupMask; //load factor limit guarantees a free slot exists
+    }
+};
+
+//moves every entry into a new slot array, also clears out any tombstones
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_FlatHashTable<Tobj, Tkey, Thash> :: rehash(int newCapacity){
+    signed char* oldCtrl = ctrl;
+    Slot* oldSlots = slots;
+    int oldCapacity = capacity;
+    allocate(newCapacity);
+    for (int i=0; i<oldCapacity; i++){
+        if (oldCtrl[i] >= 0){
+            unsigned long long h = hasher(oldSlots[i].key);
+            int j = findFree(h);
+            ctrl[j] = ctrlHash(h);
+            new (&(slots[j].key)) Tkey(std::move(oldSlots[i].key));
+            slots[j].obj = oldSlots[i].obj;
+            oldSlots[i].key.~Tkey();
+        }
+    }
+    deletedCount = 0;
+    delete[] oldCtrl;
+    ::operator delete(oldSlots);
+};
+
+//a removed slot can go straight back to empty if its group still has an empty slot, as no probe can have passed through the group
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_FlatHashTable<Tobj, Tkey, Thash> :: clearSlot(int i){
+    slots[i].key.~Tkey();
+    if (matchGroup(&(ctrl[i - (i % GROUP_SIZE)]), EMPTY) != 0){
+        ctrl[i] = EMPTY;
+    } else {
+        ctrl[i] = DELETED; //leave a tombstone so probes carry on past this slot
+        deletedCount++;
+    }
+    keyCount--;
+};
+
+//returns all the stored keys
+template <typename Tobj, typename Tkey, typename Thash>
+Tkey* mja_FlatHashTable<Tobj, Tkey, Thash> :: getKeys(){
+    if (keyCount == 0){
+        return nullptr; //no keys stored to return
+    }
+    Tkey* output = new Tkey[keyCount];
+    int kCount = 0;
+    for (int i=0; i<capacity && kCount<keyCount; i++){
+        if (ctrl[i] >= 0){
+            output[kCount++] = slots[i].key;
+        }
+    }
+    return output;
+};
+
+//add given a new entry into the table, if an item is already bound to said key then the item is overwritten
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_FlatHashTable<Tobj, Tkey, Thash> :: add(Tobj* obj, Tkey key){
+    unsigned long long h = hasher(key);
+    int i = findSlot(key, h);
+    if (i >= 0){ //item is already bound to that key, replace it destructively
+        if (slots[i].obj != nullptr){
+            delete slots[i].obj;
+        }
+        slots[i].obj = obj;
+        return KEY_OVERWRITTEN;
+    }
+    //keep at most 7/8 of the slots in use (tombstones included) so probes stay short, long long so large tables can't overflow
+    if (((long long)keyCount + deletedCount + 1) * 8 > (long long)capacity * 7){
+        bool full = ((long long)keyCount + 1) * 16 > (long long)capacity * 7;
+        if (full && capacity < MAX_CAPACITY){
+            rehash(capacity * 2); //grow when genuinely full
+        } else if (!full || deletedCount > capacity / 16){
+            rehash(capacity); //otherwise just purge tombstones, at MAX_CAPACITY the table fills past 7/8 instead
+        }
+    }
+    if (keyCount == capacity){
+        return TABLE_FULL; //no free slot is left and the table can't grow
+    }
+    i = findFree(h);
+    if (ctrl[i] == DELETED){
+        deletedCount--;
+    }
+    ctrl[i] = ctrlHash(h);
+    new (&(slots[i].key)) Tkey(key);
+    slots[i].obj = obj;
+    keyCount++;
+    return SUCCESS;
+};
+
+//remove and deallocate an object if stored inside of the table
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_FlatHashTable<Tobj, Tkey, Thash> :: rem(Tkey key){
+    int i = findSlot(key, hasher(key));
+    if (i >= 0){
+        if (slots[i].obj != nullptr){
+            delete slots[i].obj;
+        }
+        clearSlot(i);
+        return SUCCESS; //indicate that item was removed successfully
+    }
+    return NON_EXIST_KEY; //indicate that item wasn't found
+};
+
+//remove an object from the table and return a pointer to it
+template <typename Tobj, typename Tkey, typename Thash>
+Tobj* mja_FlatHashTable<Tobj, Tkey, Thash> :: pop(Tkey key){
+    int i = findSlot(key, hasher(key));
+    if (i >= 0){
+        Tobj* output = slots[i].obj;
+        clearSlot(i);
+        return output;
+    }
+    return nullptr; //not found return nullptr
+};
+
+
+#endif
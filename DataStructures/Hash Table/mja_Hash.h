@@ -0,0 +1,136 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_HASH_H
+#define MJA_HASH_H
+
+#include <cstring> //needed for memcpy, reads unaligned chunks of byte strings safely
+#include <cstdint> //needed for uintptr_t
+#include <string>
+#include <type_traits> //needed to pick out key types that have a default hash
+#include <cassert> //needed to catch a missing hash function for key types without a built in hash
+
+//hash functions shared by the hash tables, all return 64 bit hashes where every bit is well mixed
+//so the tables can mask off the bits they need rather than taking a modulo
+
+//64 bit finaliser (murmur3 fmix64), every input bit affects every output bit
+inline unsigned long long mja_hashInt(unsigned long long key){
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+//byte string hash, follows the xxHash64 short input path (8 byte lanes, then a 4 byte lane, then single bytes)
+inline unsigned long long mja_hashBytes(const void* data, unsigned long long length, unsigned long long seed){
+    const unsigned long long PRIME_1 = 0x9E3779B185EBCA87ULL;
+    const unsigned long long PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+    const unsigned long long PRIME_3 = 0x165667B19E3779F9ULL;
+    const unsigned long long PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+    const unsigned long long PRIME_5 = 0x27D4EB2F165667C5ULL;
+    const unsigned char* ptr = (const unsigned char*)data;
+    unsigned long long h = seed + PRIME_5 + length;
+    while (length >= 8){
+        unsigned long long lane;
+        std::memcpy(&lane, ptr, 8);
+        lane *= PRIME_2;
+        lane = (lane << 31) | (lane >> 33);
+        lane *= PRIME_1;
+        h ^= lane;
+        h = ((h << 27) | (h >> 37)) * PRIME_1 + PRIME_4;
+        ptr += 8;
+        length -= 8;
+    }
+    if (length >= 4){
+        unsigned int lane;
+        std::memcpy(&lane, ptr, 4);
+        h ^= (unsigned long long)lane * PRIME_1;
+        h = ((h << 23) | (h >> 41)) * PRIME_2 + PRIME_3;
+        ptr += 4;
+        length -= 4;
+    }
+    while (length > 0){
+        h ^= (*ptr) * PRIME_5;
+        h = ((h << 11) | (h >> 53)) * PRIME_1;
+        ptr++;
+        length--;
+    }
+    //final avalanche
+    h ^= h >> 33;
+    h *= PRIME_2;
+    h ^= h >> 29;
+    h *= PRIME_3;
+    h ^= h >> 32;
+    return h;
+}
+
+//built in hashes for common key types, pointers hash their address so they agree with the tables' == comparison
+template <typename Tkey>
+inline typename std::enable_if<std::is_integral<Tkey>::value || std::is_enum<Tkey>::value, unsigned long long>::type mja_defaultHash(Tkey key){
+    return mja_hashInt((unsigned long long)key);
+}
+template <typename Tkey>
+inline unsigned long long mja_defaultHash(Tkey* key){
+    return mja_hashInt((unsigned long long)reinterpret_cast<std::uintptr_t>(key));
+}
+inline unsigned long long mja_defaultHash(const std::string &key){
+    return mja_hashBytes(key.data(), key.size(), 0);
+}
+
+//detects whether a key type has a built in hash
+template <typename Tkey, typename = void>
+struct mja_HasDefaultHash : std::false_type {};
+template <typename Tkey>
+struct mja_HasDefaultHash<Tkey, decltype((void)mja_defaultHash(std::declval<Tkey>()))> : std::true_type {};
+
+//default hasher for the hash tables, uses the built in hash for the key type unless given a user hash function
+//a user hash function's output is mixed as well, so weak functions (e.g. returning the key itself) still spread over the buckets
+//can be swapped out for any type with an unsigned long long operator()(Tkey)
+template <typename Tkey>
+struct mja_Hash {
+
+    int (*hashFunction)(Tkey) = nullptr; //user set hash function, nullptr uses the built in hash
+
+    mja_Hash(){static_assert(mja_HasDefaultHash<Tkey>::value, "key type has no built in hash, give the table a hash function");};
+    mja_Hash(int(*hashFunction)(Tkey)){ //not explicit, so tables can still be given a plain hash function
+        assert((mja_HasDefaultHash<Tkey>::value || hashFunction != nullptr) && "key type has no built in hash, the hash function can't be nullptr");
+        this->hashFunction = hashFunction;
+    };
+
+    unsigned long long operator()(const Tkey &key) const {
+        if constexpr (mja_HasDefaultHash<Tkey>::value){
+            if (hashFunction == nullptr){
+                return mja_defaultHash(key);
+            }
+        }
+        return mja_hashInt((unsigned long long)(unsigned int)hashFunction(key)); //key types without a built in hash must be given a hash function
+    };
+};
+
+
+#endif
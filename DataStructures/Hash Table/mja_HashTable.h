@@ -28,6 +28,42 @@ SOFTWARE.
 #define MJA_HASHTABLE_H
 
 #include <MJA_LinkedList.h>
+#include "mja_Hash.h"
+#include "mja_BloomFilter.h" //optional filter in front of the buckets, answers most misses without walking a chain
+
+//prefetch hint used by the batched functions, does nothing on compilers without one
+#if defined(__GNUC__) || defined(__clang__)
+#define MJA_PREFETCH(ptr) __builtin_prefetch((const void*)(ptr))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define MJA_PREFETCH(ptr) _mm_prefetch((const char*)(ptr), _MM_HINT_T0)
+#else
+#define MJA_PREFETCH(ptr)
+#endif
+
+//define MJA_HASHTABLE_STATS before including to have tables count their lookups, overwrites and rehashes (see getStats)
+//counters are relaxed atomics so concurrent readers can still share a table, when not defined all of it is compiled out
+#ifdef MJA_HASHTABLE_STATS
+#include <atomic>
+
+//snapshot of a hash table's health, a bad hash function shows up as a long max chain and a mean chain well above 1
+struct mja_HashTableStats {
+    static const int HISTOGRAM_SIZE = 8;
+    int keyCount;
+    int bucketCount; //includes the unmoved buckets of an old table mid rehash
+    int usedBuckets; //buckets holding at least one key
+    int maxChainLength;
+    double meanChainLength; //mean over the used buckets, so it's the expected chain a successful lookup lands in
+    int histogram[HISTOGRAM_SIZE]; //histogram[i] is the number of buckets with a chain of length i, the last bin also counts all longer chains
+    unsigned long long hits; //lookups (get/getBatch) that found their key
+    unsigned long long misses;
+    double meanHitProbes; //entries compared per hit
+    double meanMissProbes; //entries compared per miss, misses answered by the filter count as 0
+    unsigned long long filterSkips; //misses answered by the filter without touching a bucket
+    unsigned long long overwrites; //adds that returned KEY_OVERWRITTEN
+    unsigned long long rehashes; //grows and shrinks started
+};
+#endif
 
 //keeps all error codes for the hash table together, allows for derived classes to use the same codes
 class mja_ErrorCode_HashTable {
@@ -38,12 +74,13 @@ protected:
     const int SUCCESS = 0;
     const int KEY_OVERWRITTEN = 1;
     const int NON_EXIST_KEY = 2;
+    const int TABLE_FULL = 3; //open addressing table is at its largest capacity with every slot in use, the item wasn't added
 
 };
 
 //TODO -- B TREE VERSION AS WELL AS LINKED LIST VERSION
-//chained hash table data structure
-template<typename Tobj, typename Tkey>
+//chained hash table data structure, Thash turns a key into a 64 bit hash (see mja_Hash.h)
+template<typename Tobj, typename Tkey, typename Thash = mja_Hash<Tkey>>
 class mja_HashTable : mja_ErrorCode_HashTable {
 
 private:
@@ -51,14 +88,15 @@ private:
     //Hash Table Entry Class should only be manipulated only by the hash table or the linked list that stores the entries
     class HashTableEntry {
 
-    friend class mja_HashTable<Tobj, Tkey>;
+    friend class mja_HashTable<Tobj, Tkey, Thash>;
     friend class mja_NodeLL<HashTableEntry>;
 
     private:
 
-        HashTableEntry(Tobj* obj, Tkey key){
+        HashTableEntry(Tobj* obj, Tkey key, unsigned long long hash){
             this->obj = obj;
             this->key = key;
+            this->hash = hash;
         };
         ~HashTableEntry(){
             if (obj != nullptr){
@@ -68,89 +106,369 @@ private:
 
         Tobj* obj;
         Tkey key;
+        unsigned long long hash; //stored so chain walks compare hashes before keys, and rehashing never re-hashes a key
     }; //END -- HASH TABLE ENTRY CLASS
 
 
     mja_LinkedList<HashTableEntry>* table; //dynamically assigned table of linked lists to store chained objects
-    int length; //size of table
+    int length; //size of table, always a power of 2 so the hash can be masked into range
+    int minLength; //table never shrinks below its starting size
     bool safeDestruction; //if true then stored items are not destroyed when the table is destroyed
-    int (*hashFunction)(Tkey); //user set hash function
+    Thash hasher; //hash function object, can be inlined unlike a function pointer
     int keyCount = 0;
 
-    //forces a safety catch to the hash function
-    int hashFunc(Tkey key){
-        int index = hashFunction(key);
-        if (index < 0 || index >= length){
-            index = index % length; //force index within the tables range
+    //incremental rehashing, when the table is resized the old table is kept and its buckets are moved across a few at a time
+    //old buckets below rehashIndex have been moved, the rest are still looked up in the old table
+    mja_LinkedList<HashTableEntry>* oldTable = nullptr;
+    int oldLength = 0;
+    int rehashIndex = 0;
+    static const int REHASH_STEP = 4; //non-empty buckets moved per add/rem/pop
+    static const int REHASH_EMPTY_VISITS = 40; //limits how many empty buckets a step can skip over, keeps each step bounded
+    static const int BATCH_GROUP = 16; //keys in flight at once in the batched functions, enough to overlap misses without overflowing the cache
+
+    //optional counting Bloom filter over every stored hash, lookups only walk a chain if the filter says the key may be stored
+    //counting so rem/pop can take keys back out, rebuilt from the stored hashes whenever the table outgrows it
+    mja_CountingBloomFilter<Tkey, Thash>* filter = nullptr;
+    int filterKeys = 0; //number of keys the filter is sized for
+
+#ifdef MJA_HASHTABLE_STATS
+    //health counters, not copied by the copy constructor
+    std::atomic<unsigned long long> statHits{0};
+    std::atomic<unsigned long long> statMisses{0};
+    std::atomic<unsigned long long> statHitProbes{0};
+    std::atomic<unsigned long long> statMissProbes{0};
+    std::atomic<unsigned long long> statFilterSkips{0};
+    std::atomic<unsigned long long> statOverwrites{0};
+    std::atomic<unsigned long long> statRehashes{0};
+
+    //getTableNode that also counts how many entries it compared
+    mja_NodeLL<HashTableEntry>* getTableNode(mja_LinkedList<HashTableEntry>* ptr, Tkey key, unsigned long long hash, int &probes){
+        for (mja_NodeLL<HashTableEntry>* node = ptr->getFirstNode(); node != nullptr; node = node->getNext()){
+            probes++;
+            if (node->obj->hash == hash && node->obj->key == key){
+                return node;
+            }
+        }
+        return nullptr;
+    };
+
+    //counts one lookup
+    void recordLookup(bool hit, int probes){
+        if (hit){
+            statHits.fetch_add(1, std::memory_order_relaxed);
+            statHitProbes.fetch_add((unsigned long long)probes, std::memory_order_relaxed);
+        } else {
+            statMisses.fetch_add(1, std::memory_order_relaxed);
+            statMissProbes.fetch_add((unsigned long long)probes, std::memory_order_relaxed);
+        }
+    };
+#endif
+
+    //masks the hash into the range of a table of the given length
+    static int hashIndex(unsigned long long hash, int len){
+        return (int)(hash & (unsigned long long)(len - 1));
+    };
+
+    //returns the bucket that a hash is stored in, taking into account any rehash in progress
+    mja_LinkedList<HashTableEntry>* getBucket(unsigned long long hash){
+        if (oldTable != nullptr){
+            int oldIndex = hashIndex(hash, oldLength);
+            if (oldIndex >= rehashIndex){
+                return &(oldTable[oldIndex]); //bucket hasn't been moved yet
+            }
         }
-        return index;
+        return &(table[hashIndex(hash, length)]);
     };
 
     //returns reference to specific linked list node that the object is stored at
-    mja_NodeLL<HashTableEntry>* getTableNode(mja_LinkedList<HashTableEntry>* ptr, Tkey key){
-        if(ptr->resetCycleUp()){
-            do {
-                if (ptr->cycle->obj->key == key){
-                    return ptr->cycle;
-                }
-            } while (ptr->cycleUp());
+    mja_NodeLL<HashTableEntry>* getTableNode(mja_LinkedList<HashTableEntry>* ptr, Tkey key, unsigned long long hash){
+        //walks the nodes directly rather than using the list's cycle, so lookups don't modify the table
+        for (mja_NodeLL<HashTableEntry>* node = ptr->getFirstNode(); node != nullptr; node = node->getNext()){
+            if (node->obj->hash == hash && node->obj->key == key){
+                return node;
+            }
         }
         return nullptr; //not found in the table so return nullptr
     };
 
+    void startRehash(int newLength); //swaps in a new table, entries then move across over the following operations
+    void rehashStep(); //moves a few buckets from the old table into the new one
+    void checkLoad(); //starts a grow or shrink if the load factor has left its bounds
+    static int roundLength(int length); //rounds the requested length up to a power of 2
+    int add(Tobj* obj, Tkey key, unsigned long long hash); //add with the hash already worked out
+    static void copyTable(mja_LinkedList<HashTableEntry>* from, mja_LinkedList<HashTableEntry>* to, int len); //deep copies every chain into the same bucket of another table
+    void rebuildFilter(); //resizes the filter for twice the current key count and refills it from the stored hashes
+
+    //manual cycle position, cycleTable is 0 for the current table and 1 for the old table during a rehash
+    mja_NodeLL<HashTableEntry>* cycle = nullptr;
+    int cycleTable = 0;
+    int cycleIndex = 0;
+    bool cycleSeek(); //moves the cycle to the first entry at or after (cycleTable, cycleIndex)
+    static void clearTable(mja_LinkedList<HashTableEntry>* ptr, int len, bool safe); //deallocates a table, popping entries first if needed
+
 
 public:
 
-    //base constructor
-    mja_HashTable(int length, int(*hashFunction)(Tkey), bool safeDestruction){
+    //base constructor, the table grows and shrinks with the number of keys so length is only the starting size
+    //a plain int(*)(Tkey) hash function can still be passed as the hasher, mja_Hash wraps it
+    //useFilter puts a counting Bloom filter in front of the buckets, worth it when most lookups are for keys that aren't stored
+    mja_HashTable(int length, Thash hasher, bool safeDestruction, bool useFilter) : hasher(hasher) {
         this->safeDestruction = safeDestruction; //if stored items are to be deallocated when the table is
-        this->length = length; //size of table
-        this->hashFunction = hashFunction; //set the hash function
-        this->table = new mja_LinkedList<HashTableEntry>[length]; //define table
+        this->length = roundLength(length); //size of table
+        this->minLength = this->length;
+        this->table = new mja_LinkedList<HashTableEntry>[this->length]; //define table
+        if (useFilter){
+            rebuildFilter();
+        }
     };
-    mja_HashTable(int length, int(*hashFunction)(Tkey)) : mja_HashTable(length, hashFunction, false) {}; //default setting is to destruct all stored items on exit
-    mja_HashTable(mja_HashTable<Tobj, Tkey> & oldTable); //copy constructor
+    mja_HashTable(int length, Thash hasher, bool safeDestruction) : mja_HashTable(length, hasher, safeDestruction, false) {}; //no filter by default
+    mja_HashTable(int length, Thash hasher) : mja_HashTable(length, hasher, false) {}; //default setting is to destruct all stored items on exit
+    mja_HashTable(int length) : mja_HashTable(length, Thash(), false) {}; //default hasher
+    mja_HashTable(mja_HashTable<Tobj, Tkey, Thash> & oldTable); //copy constructor
 
     ~mja_HashTable(){
-        if (safeDestruction){ //allows for hash table to be destroyed without deallocating all contents (e.g., if stored objects are used else where via ptrs)
-            for (int i=0; i < length;i++){
-                while(!table[i].isEmpty()){
-                    table[i].popFront();
-                }
-            }
+        clearTable(table, length, safeDestruction);
+        if (oldTable != nullptr){
+            clearTable(oldTable, oldLength, safeDestruction);
         }
-        delete[] table;
+        delete filter;
     };
 
     int getKeyCount(){return keyCount;};
+    bool hasFilter(){return (filter != nullptr);};
+
+#ifdef MJA_HASHTABLE_STATS
+    mja_HashTableStats getStats(); //scans every bucket for the chain lengths, the counters themselves are just read
+    void resetStats(); //zeros the lookup, overwrite and rehash counters
+#endif
     Tkey* getKeys(); //returns all the stored keys, clunky for really large tables when all items are stored towards the last indicies
 
+    //apply function to every stored (object, key) pair, doesn't allocate anything
+    template <typename Tret> void cycleFunc(Tret(*func)(Tobj*, Tkey));
+    template <typename Tret, typename Tpara> void cycleFunc(Tret(*func)(Tobj*, Tkey, Tpara*), Tpara* para);
+
+    //manual access cycle system over every stored pair, greater manual control use at your own risk!
+    //adding/removing keys can move entries between buckets, so don't change the table mid cycle
+    bool resetCycle(){cycleTable = 0; cycleIndex = 0; return cycleSeek();};
+    bool cycleNext(){cycle = cycle->getNext(); if (cycle != nullptr){return true;} cycleIndex++; return cycleSeek();};
+    Tkey getCycleKey(){return cycle->obj->key;};
+    Tobj* getCycleObj(){return cycle->obj->obj;};
+    /* example
+    if (table.resetCycle()) {
+        do {
+            table.getCycleObj()->......
+        } while(table.cycleNext());
+    }
+    */
+
     Tobj* get(Tkey key); //get an object stored with a given key
 
-    int add(Tobj* obj, Tkey key); //adds object to that key, if the key already exists then the old object is overwritten
+    int add(Tobj* obj, Tkey key){return add(obj, key, hasher(key));}; //adds object to that key, if the key already exists then the old object is overwritten
     int rem(Tkey key);
     Tobj* pop(Tkey key);
+
+    //batched versions of get and add, the whole batch is hashed and prefetched first so many cache misses are in flight at once
+    int getBatch(const Tkey* keys, int n, Tobj** out); //out[i] is set to the object stored at keys[i] (or nullptr), returns how many were found
+    void addBatch(Tobj* const* objs, const Tkey* keys, int n, int* flags); //adds each objs[i] at keys[i] in order, flags (can be nullptr) gets each add's return code
 };
 
 /*
 more lengthy/looping functions are defined below to prevent above main header getting spammed
 */
 
-//copy constructor
-template <typename Tobj,typename Tkey>
-mja_HashTable<Tobj, Tkey> :: mja_HashTable(mja_HashTable<Tobj, Tkey> &oldTable) : mja_HashTable(oldTable.length, oldTable.hashFunction, oldTable.safeDestruction) {
+//copy constructor, copies every chain straight into the same bucket so nothing is hashed or looked up again
+template <typename Tobj, typename Tkey, typename Thash>
+mja_HashTable<Tobj, Tkey, Thash> :: mja_HashTable(mja_HashTable<Tobj, Tkey, Thash> &oldTable) : mja_HashTable(oldTable.length, oldTable.hasher, oldTable.safeDestruction) {
+    this->minLength = oldTable.minLength;
+    copyTable(oldTable.table, this->table, length);
+    if (oldTable.oldTable != nullptr){ //old table is mid rehash, copy its unmoved buckets too
+        this->oldLength = oldTable.oldLength;
+        this->rehashIndex = oldTable.rehashIndex;
+        this->oldTable = new mja_LinkedList<HashTableEntry>[oldLength];
+        copyTable(oldTable.oldTable, this->oldTable, oldLength);
+    }
+    this->keyCount = oldTable.keyCount;
+    if (oldTable.filter != nullptr){
+        this->filter = new mja_CountingBloomFilter<Tkey, Thash>(*(oldTable.filter));
+        this->filterKeys = oldTable.filterKeys;
+    }
+};
+
+//swaps in a new filter sized for twice the current key count (never less than the table length) and adds every stored hash to it
+//the table stores each key's hash so nothing is hashed again, and doubling the size keeps the rebuilds amortised O(1) per add
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_HashTable<Tobj, Tkey, Thash> :: rebuildFilter(){
+    delete filter;
+    filterKeys = (keyCount * 2 > length) ? keyCount * 2 : length;
+    filter = new mja_CountingBloomFilter<Tkey, Thash>(filterKeys, 16, hasher);
+    mja_LinkedList<HashTableEntry>* tables[2] = {table, oldTable};
+    int lengths[2] = {length, oldLength};
+    for (int t=0; t<2; t++){
+        for (int i=0; i<lengths[t]; i++){
+            for (mja_NodeLL<HashTableEntry>* node = tables[t][i].getFirstNode(); node != nullptr; node = node->getNext()){
+                filter->addHash(node->obj->hash);
+            }
+        }
+    }
+};
+
+//deep copies every chain of one table into the matching bucket of another, keeping chain order and stored hashes
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_HashTable<Tobj, Tkey, Thash> :: copyTable(mja_LinkedList<HashTableEntry>* from, mja_LinkedList<HashTableEntry>* to, int len){
+    for (int i=0; i<len; i++){
+        for (mja_NodeLL<HashTableEntry>* node = from[i].getFirstNode(); node != nullptr; node = node->getNext()){
+            HashTableEntry* entry = node->obj;
+            Tobj* obj = (entry->obj != nullptr) ? new Tobj(*(entry->obj)) : nullptr;
+            to[i].addEnd(new HashTableEntry(obj, entry->key, entry->hash));
+        }
+    }
+};
+
+//finds the next non-empty bucket from the cycle's current position, moving on to the old table if a rehash is in progress
+template <typename Tobj, typename Tkey, typename Thash>
+bool mja_HashTable<Tobj, Tkey, Thash> :: cycleSeek(){
+    for (; cycleTable < 2; cycleTable++, cycleIndex = 0){
+        mja_LinkedList<HashTableEntry>* ptr = (cycleTable == 0) ? table : oldTable;
+        int len = (cycleTable == 0) ? length : oldLength;
+        for (; cycleIndex < len; cycleIndex++){
+            cycle = ptr[cycleIndex].getFirstNode();
+            if (cycle != nullptr){
+                return true;
+            }
+        }
+    }
+    cycle = nullptr;
+    return false; //no entries left
+};
+
+//apply a function to every stored pair
+template <typename Tobj, typename Tkey, typename Thash>
+template <typename Tret>
+void mja_HashTable<Tobj, Tkey, Thash> :: cycleFunc(Tret(*func)(Tobj*, Tkey)){
+    mja_LinkedList<HashTableEntry>* tables[2] = {table, oldTable};
+    int lengths[2] = {length, oldLength};
+    for (int t=0; t<2; t++){
+        for (int i=0; i<lengths[t]; i++){
+            for (mja_NodeLL<HashTableEntry>* node = tables[t][i].getFirstNode(); node != nullptr; node = node->getNext()){
+                func(node->obj->obj, node->obj->key);
+            }
+        }
+    }
+};
+
+//apply a function with multiple parameters (e.g. array of parameters, pointer to structure, etc) to every stored pair
+template <typename Tobj, typename Tkey, typename Thash>
+template <typename Tret, typename Tpara>
+void mja_HashTable<Tobj, Tkey, Thash> :: cycleFunc(Tret(*func)(Tobj*, Tkey, Tpara*), Tpara* para){
+    mja_LinkedList<HashTableEntry>* tables[2] = {table, oldTable};
+    int lengths[2] = {length, oldLength};
+    for (int t=0; t<2; t++){
+        for (int i=0; i<lengths[t]; i++){
+            for (mja_NodeLL<HashTableEntry>* node = tables[t][i].getFirstNode(); node != nullptr; node = node->getNext()){
+                func(node->obj->obj, node->obj->key, para);
+            }
+        }
+    }
+};
+
+//rounds the requested length up to a power of 2
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_HashTable<Tobj, Tkey, Thash> :: roundLength(int length){
+    int output = 1;
+    while (output < length){
+        output *= 2;
+    }
+    return output;
+};
+
+//deallocates a table of linked lists
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_HashTable<Tobj, Tkey, Thash> :: clearTable(mja_LinkedList<HashTableEntry>* ptr, int len, bool safe){
+    if (safe){ //allows for hash table to be destroyed without deallocating all contents (e.g., if stored objects are used else where via ptrs)
+        for (int i=0; i < len;i++){
+            while(!ptr[i].isEmpty()){
+                HashTableEntry* entry = ptr[i].popFront();
+                entry->obj = nullptr; //clear entry's ptr so object isn't destroyed
+                delete entry;
+            }
+        }
+    }
+    delete[] ptr;
+};
 
-    Tkey* keys = oldTable.getKeys(); //get all keys stored in the old table
-    for (int i=0; i<oldTable.getKeyCount();i++){
-        this->add(new Tobj(*(oldTable.get(keys[i]))), keys[i]); //add them one by one into the new table
+//swaps in a new table of the given length, keeping the current one as the old table until all of its buckets are moved
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_HashTable<Tobj, Tkey, Thash> :: startRehash(int newLength){
+#ifdef MJA_HASHTABLE_STATS
+    statRehashes.fetch_add(1, std::memory_order_relaxed);
+#endif
+    oldTable = table;
+    oldLength = length;
+    rehashIndex = 0;
+    table = new mja_LinkedList<HashTableEntry>[newLength];
+    length = newLength;
+};
+
+//moves up to REHASH_STEP non-empty buckets into the new table, nodes are spliced across so nothing is reallocated
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_HashTable<Tobj, Tkey, Thash> :: rehashStep(){
+    if (oldTable == nullptr){
+        return; //no rehash in progress
+    }
+    int moved = 0;
+    int emptyVisits = 0;
+    while (rehashIndex < oldLength && moved < REHASH_STEP && emptyVisits < REHASH_EMPTY_VISITS){
+        mja_LinkedList<HashTableEntry>* bucket = &(oldTable[rehashIndex]);
+        if (bucket->isEmpty()){
+            emptyVisits++;
+        } else {
+            while (!bucket->isEmpty()){
+                mja_NodeLL<HashTableEntry>* node = bucket->getFirstNode();
+                table[hashIndex(node->obj->hash, length)].splice(nullptr, *bucket, node, node, 1);
+            }
+            moved++;
+        }
+        rehashIndex++;
+    }
+    if (rehashIndex >= oldLength){ //all buckets moved, old table is now empty
+        delete[] oldTable;
+        oldTable = nullptr;
+        oldLength = 0;
+        rehashIndex = 0;
+    }
+};
+
+//grows once there's more than one key per bucket, shrinks once there's less than one key per 8 buckets
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_HashTable<Tobj, Tkey, Thash> :: checkLoad(){
+    if (oldTable != nullptr){
+        return; //let the current rehash finish first
+    }
+    if (keyCount > length){
+        startRehash(length * 2);
+    } else if (length > minLength && keyCount * 8 < length){
+        startRehash(length / 2);
     }
-    delete[] keys;
 };
 
 //access a stored object given the key
-template <typename Tobj,typename Tkey>
-Tobj* mja_HashTable<Tobj, Tkey> :: get(Tkey key){
-    mja_NodeLL<HashTableEntry>* nodePtr = getTableNode(&(table[hashFunc(key)]), key);
+template <typename Tobj, typename Tkey, typename Thash>
+Tobj* mja_HashTable<Tobj, Tkey, Thash> :: get(Tkey key){
+    unsigned long long hash = hasher(key);
+    if (filter != nullptr && !filter->mayContainHash(hash)){
+    #ifdef MJA_HASHTABLE_STATS
+        statFilterSkips.fetch_add(1, std::memory_order_relaxed);
+        recordLookup(false, 0);
+    #endif
+        return nullptr; //definitely not stored, no need to touch the bucket
+    }
+#ifdef MJA_HASHTABLE_STATS
+    int probes = 0;
+    mja_NodeLL<HashTableEntry>* nodePtr = getTableNode(getBucket(hash), key, hash, probes);
+    recordLookup(nodePtr != nullptr, probes);
+#else
+    mja_NodeLL<HashTableEntry>* nodePtr = getTableNode(getBucket(hash), key, hash);
+#endif
     if (nodePtr != nullptr){
         return nodePtr->obj->obj; //NodeLL -> HashTableEntry -> Tobj
     } else {
@@ -159,69 +477,185 @@ Tobj* mja_HashTable<Tobj, Tkey> :: get(Tkey key){
 };
 
 //returns all the stored keys
-template <typename Tobj, typename Tkey>
-Tkey* mja_HashTable<Tobj, Tkey> :: getKeys(){
+template <typename Tobj, typename Tkey, typename Thash>
+Tkey* mja_HashTable<Tobj, Tkey, Thash> :: getKeys(){
     if (keyCount == 0){
         return nullptr; //no keys stored to return
     }
     Tkey* output = new Tkey[keyCount];
     int kCount = 0;
-    for (int i=0;i<length;i++){
-        mja_LinkedList<HashTableEntry>* index = &(table[i]); //get table index at i
-        //attempt to scan for entries
-        if (index->resetCycleUp()){
-            do {
-                output[kCount] = index->cycle->obj->key;
+    //scan the old table as well if a rehash is in progress
+    mja_LinkedList<HashTableEntry>* tables[2] = {table, oldTable};
+    int lengths[2] = {length, oldLength};
+    for (int t=0; t<2 && kCount<keyCount; t++){
+        for (int i=0;i<lengths[t];i++){
+            mja_LinkedList<HashTableEntry>* index = &(tables[t][i]); //get table index at i
+            //attempt to scan for entries
+            for (mja_NodeLL<HashTableEntry>* node = index->getFirstNode(); node != nullptr; node = node->getNext()){
+                output[kCount] = node->obj->key;
                 kCount++;
-            } while (index->cycleUp());
-        }
-        if(kCount >= keyCount) {
-            break; //found all items, no point scanning down the rest of the table
+            }
+            if(kCount >= keyCount) {
+                break; //found all items, no point scanning down the rest of the table
+            }
         }
     }
     return output;
 };
 
 //add given a new entry into the table, if an item is already bound to said key then the item is overwritten
-template <typename Tobj,typename Tkey>
-int mja_HashTable<Tobj, Tkey> :: add(Tobj* obj, Tkey key){
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_HashTable<Tobj, Tkey, Thash> :: add(Tobj* obj, Tkey key, unsigned long long hash){
     int flag = SUCCESS;
-    mja_LinkedList<HashTableEntry>* index = &(table[hashFunc(key)]);
-    mja_NodeLL<HashTableEntry>* nodePtr = getTableNode(index, key);
+    rehashStep();
+    mja_LinkedList<HashTableEntry>* index = getBucket(hash);
+    mja_NodeLL<HashTableEntry>* nodePtr = getTableNode(index, key, hash);
     if (nodePtr != nullptr){ //item is already bound to that key, replace it destructively -- can do so non-destructively by manually poping key first
         index->remNode(nodePtr);
         flag = KEY_OVERWRITTEN;
+    #ifdef MJA_HASHTABLE_STATS
+        statOverwrites.fetch_add(1, std::memory_order_relaxed);
+    #endif
     } else {
         keyCount++; //inc stored key count
     }
-    index->addEnd(new HashTableEntry(obj, key));
+    index->addEnd(new HashTableEntry(obj, key, hash));
+    if (filter != nullptr && flag == SUCCESS){
+        if (keyCount > filterKeys){
+            rebuildFilter(); //picks up the new entry as well
+        } else {
+            filter->addHash(hash);
+        }
+    }
+    checkLoad();
     return flag; //indicate whether the key was occupied or not
 };
 
+//batched lookup, works through the keys in groups, each group is resolved in stages so that every stage's loads are already on their way
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_HashTable<Tobj, Tkey, Thash> :: getBatch(const Tkey* keys, int n, Tobj** out){
+    int found = 0;
+    unsigned long long hashes[BATCH_GROUP];
+    mja_LinkedList<HashTableEntry>* buckets[BATCH_GROUP];
+    mja_NodeLL<HashTableEntry>* heads[BATCH_GROUP];
+    for (int start=0; start<n; start+=BATCH_GROUP){
+        int count = (n - start < BATCH_GROUP) ? n - start : BATCH_GROUP;
+        //stage 1, hash every key and prefetch its bucket, keys the filter rules out are skipped from here on
+        for (int i=0; i<count; i++){
+            hashes[i] = hasher(keys[start+i]);
+            if (filter != nullptr && !filter->mayContainHash(hashes[i])){
+                buckets[i] = nullptr;
+            #ifdef MJA_HASHTABLE_STATS
+                statFilterSkips.fetch_add(1, std::memory_order_relaxed);
+            #endif
+                continue;
+            }
+            buckets[i] = getBucket(hashes[i]);
+            MJA_PREFETCH(buckets[i]);
+        }
+        //stage 2, read each bucket's first node and prefetch it
+        for (int i=0; i<count; i++){
+            heads[i] = (buckets[i] != nullptr) ? buckets[i]->getFirstNode() : nullptr;
+            if (heads[i] != nullptr){
+                MJA_PREFETCH(heads[i]);
+            }
+        }
+        //stage 3, prefetch the entry the first node points to, which is where the key lives
+        for (int i=0; i<count; i++){
+            if (heads[i] != nullptr){
+                MJA_PREFETCH(heads[i]->obj);
+            }
+        }
+        //stage 4, walk the chains, the first entry of each is now likely to be cached
+        for (int i=0; i<count; i++){
+            out[start+i] = nullptr;
+        #ifdef MJA_HASHTABLE_STATS
+            int probes = 0;
+            bool hit = false;
+        #endif
+            for (mja_NodeLL<HashTableEntry>* node = heads[i]; node != nullptr; node = node->getNext()){
+            #ifdef MJA_HASHTABLE_STATS
+                probes++;
+            #endif
+                if (node->obj->hash == hashes[i] && node->obj->key == keys[start+i]){
+                    out[start+i] = node->obj->obj;
+                    found++;
+                #ifdef MJA_HASHTABLE_STATS
+                    hit = true;
+                #endif
+                    break;
+                }
+            }
+        #ifdef MJA_HASHTABLE_STATS
+            recordLookup(hit, probes);
+        #endif
+        }
+    }
+    return found;
+};
+
+//batched add, prefetches each group's buckets before adding, adds still happen in order so repeated keys act the same as calling add in a loop
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_HashTable<Tobj, Tkey, Thash> :: addBatch(Tobj* const* objs, const Tkey* keys, int n, int* flags){
+    for (int start=0; start<n; start+=BATCH_GROUP){
+        int count = (n - start < BATCH_GROUP) ? n - start : BATCH_GROUP;
+        //buckets can move as the table resizes, so only the prefetch is done ahead of time, each add finds its own bucket again
+        unsigned long long hashes[BATCH_GROUP];
+        for (int i=0; i<count; i++){
+            hashes[i] = hasher(keys[start+i]);
+            MJA_PREFETCH(getBucket(hashes[i]));
+        }
+        for (int i=0; i<count; i++){
+            mja_NodeLL<HashTableEntry>* head = getBucket(hashes[i])->getFirstNode();
+            if (head != nullptr){
+                MJA_PREFETCH(head);
+            }
+        }
+        for (int i=0; i<count; i++){
+            int flag = add(objs[start+i], keys[start+i], hashes[i]);
+            if (flags != nullptr){
+                flags[start+i] = flag;
+            }
+        }
+    }
+};
+
 //remove and deallocate an object if stored inside of the table
-template <typename Tobj,typename Tkey>
-int mja_HashTable<Tobj, Tkey> :: rem(Tkey key){
-    mja_LinkedList<HashTableEntry>* index = &(table[hashFunc(key)]);
-    mja_NodeLL<HashTableEntry>* nodePtr = getTableNode(index, key);
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_HashTable<Tobj, Tkey, Thash> :: rem(Tkey key){
+    rehashStep();
+    unsigned long long hash = hasher(key);
+    mja_LinkedList<HashTableEntry>* index = getBucket(hash);
+    mja_NodeLL<HashTableEntry>* nodePtr = getTableNode(index, key, hash);
     if (nodePtr != nullptr){
         index->remNode(nodePtr);
+        if (filter != nullptr){
+            filter->remHash(hash);
+        }
         keyCount--; //decrement key count
+        checkLoad();
         return SUCCESS; //indicate that item was removed successfully
     }
     return NON_EXIST_KEY; //indicate that item wasn't found
 };
 
 //remove an object from the table and return a pointer to it
-template <typename Tobj,typename Tkey>
-Tobj* mja_HashTable<Tobj, Tkey> :: pop(Tkey key){
-    mja_LinkedList<HashTableEntry>* index = &(table[hashFunc(key)]);
-    mja_NodeLL<HashTableEntry>* nodePtr = getTableNode(index, key);
+template <typename Tobj, typename Tkey, typename Thash>
+Tobj* mja_HashTable<Tobj, Tkey, Thash> :: pop(Tkey key){
+    rehashStep();
+    unsigned long long hash = hasher(key);
+    mja_LinkedList<HashTableEntry>* index = getBucket(hash);
+    mja_NodeLL<HashTableEntry>* nodePtr = getTableNode(index, key, hash);
     if (nodePtr != nullptr){
         HashTableEntry* entry = index->popNode(nodePtr); //pop entry off the linked list, deallocating the linked list node
         Tobj* output = entry->obj; //get object to return
         entry->obj = nullptr; //clear entry's ptr so object isn't destroyed
         delete entry; //deallocate memory for entry
+        if (filter != nullptr){
+            filter->remHash(hash);
+        }
         keyCount--; //decrement key count
+        checkLoad();
         return output; //return object pointer
     } else {
         return nullptr; //not found return nullptr
@@ -229,4 +663,56 @@ Tobj* mja_HashTable<Tobj, Tkey> :: pop(Tkey key){
 };
 
 
+#ifdef MJA_HASHTABLE_STATS
+//builds a stats snapshot, chain lengths come from a scan of every bucket so this is O(table length)
+template <typename Tobj, typename Tkey, typename Thash>
+mja_HashTableStats mja_HashTable<Tobj, Tkey, Thash> :: getStats(){
+    mja_HashTableStats output;
+    output.keyCount = keyCount;
+    output.bucketCount = length + ((oldTable != nullptr) ? oldLength - rehashIndex : 0);
+    output.usedBuckets = 0;
+    output.maxChainLength = 0;
+    for (int i=0; i<mja_HashTableStats::HISTOGRAM_SIZE; i++){
+        output.histogram[i] = 0;
+    }
+    //only the old table's unmoved buckets still hold entries
+    mja_LinkedList<HashTableEntry>* tables[2] = {table, oldTable};
+    int starts[2] = {0, rehashIndex};
+    int lengths[2] = {length, oldLength};
+    for (int t=0; t<2; t++){
+        for (int i=starts[t]; i<lengths[t]; i++){
+            int chain = tables[t][i].getNodeCount();
+            output.histogram[(chain < mja_HashTableStats::HISTOGRAM_SIZE) ? chain : mja_HashTableStats::HISTOGRAM_SIZE - 1]++;
+            if (chain > 0){
+                output.usedBuckets++;
+            }
+            if (chain > output.maxChainLength){
+                output.maxChainLength = chain;
+            }
+        }
+    }
+    output.meanChainLength = (output.usedBuckets > 0) ? (double)keyCount / output.usedBuckets : 0.0;
+    output.hits = statHits.load(std::memory_order_relaxed);
+    output.misses = statMisses.load(std::memory_order_relaxed);
+    output.meanHitProbes = (output.hits > 0) ? (double)statHitProbes.load(std::memory_order_relaxed) / output.hits : 0.0;
+    output.meanMissProbes = (output.misses > 0) ? (double)statMissProbes.load(std::memory_order_relaxed) / output.misses : 0.0;
+    output.filterSkips = statFilterSkips.load(std::memory_order_relaxed);
+    output.overwrites = statOverwrites.load(std::memory_order_relaxed);
+    output.rehashes = statRehashes.load(std::memory_order_relaxed);
+    return output;
+};
+
+//zeros every counter, chain lengths aren't counters so they're unaffected
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_HashTable<Tobj, Tkey, Thash> :: resetStats(){
+    statHits.store(0, std::memory_order_relaxed);
+    statMisses.store(0, std::memory_order_relaxed);
+    statHitProbes.store(0, std::memory_order_relaxed);
+    statMissProbes.store(0, std::memory_order_relaxed);
+    statFilterSkips.store(0, std::memory_order_relaxed);
+    statOverwrites.store(0, std::memory_order_relaxed);
+    statRehashes.store(0, std::memory_order_relaxed);
+};
+#endif
+
 #endif
@@ -0,0 +1,323 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_HASHTABLESNAPSHOT_H
+#define MJA_HASHTABLESNAPSHOT_H
+
+#include "mja_HashTable.h"
+#include <cstdio> //needed for writing snapshots
+#include <cstring>
+#include <type_traits> //needed to check keys and objects can be written out byte for byte
+
+//map the file straight into memory where possible, otherwise fall back to reading it into a buffer
+#if defined(__unix__) || defined(__APPLE__)
+#define MJA_SNAPSHOT_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//keeps all error codes for hash table snapshots together
+class mja_ErrorCode_HashTableSnapshot {
+
+protected:
+
+    //operation success indicator constants
+    const int SUCCESS = 0;
+    const int FILE_ERROR = 1; //file couldn't be opened, read, written or mapped
+    const int BAD_FORMAT = 2; //file isn't a snapshot, or was saved with different key/object types
+
+};
+
+//read only, position independent on disk copy of a hash table
+//the file is a header, then a bucket offset array, then every entry grouped by bucket, with offsets in place of pointers
+//so a saved file can be mapped straight into memory and queried without rebuilding anything
+//keys and objects are copied byte for byte, so both must be trivially copyable (no pointers to heap memory etc)
+template<typename Tobj, typename Tkey, typename Thash = mja_Hash<Tkey>>
+class mja_HashTableSnapshot : mja_ErrorCode_HashTableSnapshot {
+
+    static_assert(std::is_trivially_copyable<Tobj>::value, "snapshot objects must be trivially copyable");
+    static_assert(std::is_trivially_copyable<Tkey>::value, "snapshot keys must be trivially copyable");
+
+private:
+
+    struct Header {
+        char magic[8];
+        unsigned int version;
+        unsigned int keySize; //key, object and entry sizes catch files saved with different key/object types
+        unsigned int objSize;
+        unsigned int entrySize;
+        unsigned long long bucketCount; //always a power of 2
+        unsigned long long entryCount;
+        unsigned long long bucketOffset; //byte offset of the bucket array from the start of the file
+        unsigned long long entryOffset; //byte offset of the entry array from the start of the file
+    };
+
+    struct Entry {
+        unsigned long long hash;
+        Tkey key;
+        Tobj obj;
+    };
+
+    static const unsigned int VERSION = 1;
+
+    Thash hasher; //must hash keys the same way as the hasher used when saving
+    const char* data = nullptr; //start of the loaded file
+    unsigned long long dataSize = 0;
+    bool mapped = false; //whether data is mapped memory or a heap buffer
+    const unsigned long long* buckets = nullptr; //entries in bucket i are entries[buckets[i]] to entries[buckets[i+1]]
+    const Entry* entries = nullptr;
+    unsigned long long bucketMask = 0;
+    unsigned long long entryCount = 0;
+
+    static void setMagic(char* magic){std::memcpy(magic, "MJAHTSNP", 8);};
+    static unsigned long long alignOffset(unsigned long long offset){return (offset + 63) & ~(unsigned long long)63;}; //keeps arrays cache line aligned
+
+public:
+
+    mja_HashTableSnapshot(Thash hasher) : hasher(hasher) {};
+    mja_HashTableSnapshot() : mja_HashTableSnapshot(Thash()) {};
+    mja_HashTableSnapshot(mja_HashTableSnapshot<Tobj, Tkey, Thash> &oldSnapshot) = delete; //owns its mapping, load the file again instead
+    ~mja_HashTableSnapshot(){close();};
+
+    int save(mja_HashTable<Tobj, Tkey, Thash> &table, const char* path); //writes the table out as a snapshot file, entries with a nullptr object are skipped
+    int load(const char* path); //maps a snapshot file in read only, replacing any already loaded
+    void close(); //unmaps the loaded snapshot, any pointers returned by get become invalid
+
+    bool isLoaded(){return (data != nullptr);};
+    unsigned long long getKeyCount(){return entryCount;};
+    const Tobj* get(Tkey key); //returns a pointer into the mapped file, valid until the snapshot is closed
+};
+
+/*
+more lengthy/looping functions are defined below to prevent above main header getting spammed
+*/
+
+//writes the table out as a snapshot, entries are bucketed with a counting pass then a placing pass so they end up contiguous per bucket
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_HashTableSnapshot<Tobj, Tkey, Thash> :: save(mja_HashTable<Tobj, Tkey, Thash> &table, const char* path){
+    unsigned long long count = 0;
+    if (table.resetCycle()){
+        do {
+            if (table.getCycleObj() != nullptr){
+                count++;
+            }
+        } while (table.cycleNext());
+    }
+    unsigned long long bucketCount = 1;
+    while (bucketCount < count){
+        bucketCount *= 2; //one bucket per entry keeps each scan to a couple of entries
+    }
+
+    //count entries per bucket, then turn the counts into start offsets
+    unsigned long long* offsets = new unsigned long long[bucketCount + 1];
+    for (unsigned long long i=0; i<=bucketCount; i++){
+        offsets[i] = 0;
+    }
+    if (table.resetCycle()){
+        do {
+            if (table.getCycleObj() != nullptr){
+                offsets[(hasher(table.getCycleKey()) & (bucketCount - 1)) + 1]++;
+            }
+        } while (table.cycleNext());
+    }
+    for (unsigned long long i=0; i<bucketCount; i++){
+        offsets[i+1] += offsets[i];
+    }
+
+    //place each entry into its bucket's range
+    Entry* output = new Entry[count > 0 ? count : 1];
+    unsigned long long* fill = new unsigned long long[bucketCount];
+    for (unsigned long long i=0; i<bucketCount; i++){
+        fill[i] = offsets[i];
+    }
+    if (table.resetCycle()){
+        do {
+            if (table.getCycleObj() != nullptr){
+                unsigned long long h = hasher(table.getCycleKey());
+                Entry* entry = &(output[fill[h & (bucketCount - 1)]++]);
+                std::memset((void*)entry, 0, sizeof(Entry)); //zero any padding so snapshots of the same table are identical
+                entry->hash = h;
+                entry->key = table.getCycleKey();
+                entry->obj = *(table.getCycleObj());
+            }
+        } while (table.cycleNext());
+    }
+    delete[] fill;
+
+    Header header;
+    std::memset(&header, 0, sizeof(Header));
+    setMagic(header.magic);
+    header.version = VERSION;
+    header.keySize = sizeof(Tkey);
+    header.objSize = sizeof(Tobj);
+    header.entrySize = sizeof(Entry);
+    header.bucketCount = bucketCount;
+    header.entryCount = count;
+    header.bucketOffset = alignOffset(sizeof(Header));
+    header.entryOffset = alignOffset(header.bucketOffset + (bucketCount + 1) * sizeof(unsigned long long));
+
+    int flag = SUCCESS;
+    FILE* file = std::fopen(path, "wb");
+    if (file == nullptr){
+        flag = FILE_ERROR;
+    } else {
+        static const char padding[64] = {0};
+        bool ok = (std::fwrite(&header, sizeof(Header), 1, file) == 1);
+        ok = ok && (std::fwrite(padding, 1, header.bucketOffset - sizeof(Header), file) == header.bucketOffset - sizeof(Header));
+        ok = ok && (std::fwrite(offsets, sizeof(unsigned long long), bucketCount + 1, file) == bucketCount + 1);
+        unsigned long long gap = header.entryOffset - (header.bucketOffset + (bucketCount + 1) * sizeof(unsigned long long));
+        ok = ok && (std::fwrite(padding, 1, gap, file) == gap);
+        ok = ok && (count == 0 || std::fwrite(output, sizeof(Entry), count, file) == count);
+        ok = (std::fclose(file) == 0) && ok;
+        if (!ok){
+            flag = FILE_ERROR;
+        }
+    }
+    delete[] offsets;
+    delete[] output;
+    return flag;
+};
+
+//maps a snapshot file in and checks that its header matches this snapshot's key/object types
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_HashTableSnapshot<Tobj, Tkey, Thash> :: load(const char* path){
+    close();
+#ifdef MJA_SNAPSHOT_MMAP
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0){
+        return FILE_ERROR;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0){
+        ::close(fd);
+        return FILE_ERROR;
+    }
+    if (info.st_size < (off_t)sizeof(Header)){
+        ::close(fd);
+        return BAD_FORMAT; //too small to even hold a header
+    }
+    void* ptr = ::mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); //mapping stays valid after the file is closed
+    if (ptr == MAP_FAILED){
+        return FILE_ERROR;
+    }
+    data = (const char*)ptr;
+    dataSize = (unsigned long long)info.st_size;
+    mapped = true;
+#else
+    FILE* file = std::fopen(path, "rb");
+    if (file == nullptr){
+        return FILE_ERROR;
+    }
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    if (size < (long)sizeof(Header)){
+        std::fclose(file);
+        return BAD_FORMAT;
+    }
+    char* buffer = (char*)::operator new((size_t)size); //operator new is aligned enough for the entries
+    if (std::fread(buffer, 1, (size_t)size, file) != (size_t)size){
+        std::fclose(file);
+        ::operator delete(buffer);
+        return FILE_ERROR;
+    }
+    std::fclose(file);
+    data = buffer;
+    dataSize = (unsigned long long)size;
+    mapped = false;
+#endif
+
+    //validate the header before trusting any offsets in it
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    char magic[8];
+    setMagic(magic);
+    bool valid = (std::memcmp(header.magic, magic, 8) == 0) && header.version == VERSION;
+    valid = valid && header.keySize == sizeof(Tkey) && header.objSize == sizeof(Tobj) && header.entrySize == sizeof(Entry);
+    valid = valid && header.bucketCount != 0 && (header.bucketCount & (header.bucketCount - 1)) == 0;
+    valid = valid && header.bucketOffset % alignof(unsigned long long) == 0 && header.entryOffset % alignof(Entry) == 0;
+    valid = valid && header.bucketOffset <= dataSize && header.entryOffset <= dataSize;
+    valid = valid && header.bucketCount < (dataSize - header.bucketOffset) / sizeof(unsigned long long); //counts are compared to the space left by division, so huge counts can't wrap past the check
+    valid = valid && header.entryCount <= (dataSize - header.entryOffset) / sizeof(Entry);
+    if (!valid){
+        close();
+        return BAD_FORMAT;
+    }
+    buckets = (const unsigned long long*)(data + header.bucketOffset);
+    entries = (const Entry*)(data + header.entryOffset);
+    if (buckets[header.bucketCount] != header.entryCount){
+        close();
+        return BAD_FORMAT;
+    }
+    bucketMask = header.bucketCount - 1;
+    entryCount = header.entryCount;
+    return SUCCESS;
+};
+
+//releases the loaded file
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_HashTableSnapshot<Tobj, Tkey, Thash> :: close(){
+    if (data != nullptr){
+    #ifdef MJA_SNAPSHOT_MMAP
+        if (mapped){
+            ::munmap((void*)data, (size_t)dataSize);
+        } else {
+            ::operator delete((void*)data);
+        }
+    #else
+        ::operator delete((void*)data);
+    #endif
+    }
+    data = nullptr;
+    dataSize = 0;
+    buckets = nullptr;
+    entries = nullptr;
+    bucketMask = 0;
+    entryCount = 0;
+};
+
+//scans the key's bucket, which is a contiguous run of entries so it's usually a single cache line
+template <typename Tobj, typename Tkey, typename Thash>
+const Tobj* mja_HashTableSnapshot<Tobj, Tkey, Thash> :: get(Tkey key){
+    if (data == nullptr){
+        return nullptr; //nothing loaded
+    }
+    unsigned long long h = hasher(key);
+    unsigned long long b = h & bucketMask;
+    unsigned long long end = (buckets[b+1] < entryCount) ? buckets[b+1] : entryCount; //never trust the file to stay in range
+    for (unsigned long long i = buckets[b]; i < end; i++){
+        if (entries[i].hash == h && entries[i].key == key){
+            return &(entries[i].obj);
+        }
+    }
+    return nullptr; //not found return nullptr
+};
+
+
+#endif
@@ -0,0 +1,290 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_ROBINHOODHASHTABLE_H
+#define MJA_ROBINHOODHASHTABLE_H
+
+#include "mja_HashTable.h" //shares the hash table error codes
+#include <new> //needed for placement new, keys are constructed in place inside of the slot array
+#include <utility> //needed for std::move and std::swap
+
+//open addressing hash table using Robin Hood linear probing
+//an entry that has probed further than the slot's current entry takes the slot and the poorer entry moves on, keeping all probe lengths close together
+//misses stop as soon as they reach an entry that's closer to home than the probe, and removals shift entries back rather than leaving tombstones
+template<typename Tobj, typename Tkey, typename Thash = mja_Hash<Tkey>>
+class mja_RobinHoodHashTable : mja_ErrorCode_HashTable {
+
+private:
+
+    struct Slot {
+        Tkey key;
+        Tobj* obj;
+        unsigned int hash; //stored so probes compare hashes before keys and rehashing never calls the hash function
+    };
+
+    unsigned int* dists; //probe distance + 1 of each slot's entry, 0 marks an empty slot
+    Slot* slots; //slot storage, only slots with a non zero distance hold a constructed key
+    int capacity; //always a power of 2
+    int keyCount = 0;
+    double maxLoad; //fraction of slots that can be filled before the table grows
+    bool safeDestruction; //if true then stored items are not destroyed when the table is destroyed
+    Thash hasher; //hash function object
+
+    //low 32 bits of the hasher's well mixed output, enough to index any table an int can count
+    unsigned int hashFunc(Tkey key){
+        return (unsigned int)hasher(key);
+    };
+
+    int findSlot(Tkey key, unsigned int h); //returns the slot index holding the key, or -1 if it isn't stored
+    void insert(Tkey key, Tobj* obj, unsigned int h); //places a new entry, displacing richer entries along the way
+    void clearSlot(int i); //removes the entry at slot i, shifting the following entries back
+    void rehash(int newCapacity);
+    void allocate(int newCapacity);
+
+public:
+
+    //base constructor, length is the starting number of slots (rounded up to a power of 2), the table grows once maxLoad is reached
+    mja_RobinHoodHashTable(int length, Thash hasher, bool safeDestruction, double maxLoad);
+    mja_RobinHoodHashTable(int length, Thash hasher, bool safeDestruction) : mja_RobinHoodHashTable(length, hasher, safeDestruction, 0.9) {};
+    mja_RobinHoodHashTable(int length, Thash hasher) : mja_RobinHoodHashTable(length, hasher, false) {}; //default setting is to destruct all stored items on exit
+    mja_RobinHoodHashTable(int length) : mja_RobinHoodHashTable(length, Thash(), false) {}; //default hasher
+    mja_RobinHoodHashTable(mja_RobinHoodHashTable<Tobj, Tkey, Thash> &oldTable); //copy constructor
+
+    ~mja_RobinHoodHashTable(){
+        for (int i=0; i<capacity; i++){
+            if (dists[i] != 0){
+                if (!safeDestruction && slots[i].obj != nullptr){
+                    delete slots[i].obj;
+                }
+                slots[i].key.~Tkey();
+            }
+        }
+        delete[] dists;
+        ::operator delete(slots);
+    };
+
+    int getKeyCount(){return keyCount;};
+    Tkey* getKeys(); //returns all the stored keys
+    int getMaxProbeLength(); //longest probe any stored key needs, useful for checking the hash function spreads keys well
+
+    Tobj* get(Tkey key){int i = findSlot(key, hashFunc(key)); return (i >= 0) ? slots[i].obj : nullptr;}; //get an object stored with a given key
+
+    int add(Tobj* obj, Tkey key); //adds object to that key, if the key already exists then the old object is overwritten
+    int rem(Tkey key);
+    Tobj* pop(Tkey key);
+};
+
+/*
+more lengthy/looping functions are defined below to prevent above main header getting spammed
+*/
+
+//base constructor
+template <typename Tobj, typename Tkey, typename Thash>
+mja_RobinHoodHashTable<Tobj, Tkey, Thash> :: mja_RobinHoodHashTable(int length, Thash hasher, bool safeDestruction, double maxLoad) : hasher(hasher) {
+    this->safeDestruction = safeDestruction;
+    this->maxLoad = (maxLoad > 0.0 && maxLoad < 1.0) ? maxLoad : 0.9; //table must always keep an empty slot
+    int newCapacity = 8;
+    while (newCapacity < length){
+        newCapacity *= 2;
+    }
+    allocate(newCapacity);
+};
+
+//copy constructor, copies the slot layout directly so nothing needs rehashing
+template <typename Tobj, typename Tkey, typename Thash>
+mja_RobinHoodHashTable<Tobj, Tkey, Thash> :: mja_RobinHoodHashTable(mja_RobinHoodHashTable<Tobj, Tkey, Thash> &oldTable) : hasher(oldTable.hasher) {
+    this->safeDestruction = oldTable.safeDestruction;
+    this->maxLoad = oldTable.maxLoad;
+    allocate(oldTable.capacity);
+    for (int i=0; i<capacity; i++){
+        dists[i] = oldTable.dists[i];
+        if (dists[i] != 0){
+            new (&(slots[i].key)) Tkey(oldTable.slots[i].key);
+            slots[i].obj = new Tobj(*(oldTable.slots[i].obj));
+            slots[i].hash = oldTable.slots[i].hash;
+        }
+    }
+    this->keyCount = oldTable.keyCount;
+};
+
+//allocates empty distances and raw slot memory
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_RobinHoodHashTable<Tobj, Tkey, Thash> :: allocate(int newCapacity){
+    capacity = newCapacity;
+    dists = new unsigned int[capacity];
+    for (int i=0; i<capacity; i++){
+        dists[i] = 0;
+    }
+    slots = static_cast<Slot*>(::operator new(sizeof(Slot) * capacity)); //raw memory so keys don't need a default constructor
+};
+
+//linear probe from the key's home slot, gives up once the probe has gone further than the entry it's looking at
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_RobinHoodHashTable<Tobj, Tkey, Thash> :: findSlot(Tkey key, unsigned int h){
+    int mask = capacity - 1;
+    int i = (int)(h & (unsigned int)mask);
+    for (unsigned int d = 1; d <= dists[i]; d++){ //stored key would have displaced any entry closer to home, so it can't be further along
+        if (slots[i].hash == h && slots[i].key == key){
+            return i;
+        }
+        i = (i + 1) & mask;
+    }
+    return -1;
+};
+
+//inserts an entry known not to be in the table, swapping it with any entry that's closer to home than it
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_RobinHoodHashTable<Tobj, Tkey, Thash> :: insert(Tkey key, Tobj* obj, unsigned int h){
+    int mask = capacity - 1;
+    int i = (int)(h & (unsigned int)mask);
+    unsigned int d = 1;
+    while (dists[i] != 0){
+        if (dists[i] < d){ //slot's entry is richer so the carried entry takes its place
+            std::swap(d, dists[i]);
+            std::swap(key, slots[i].key);
+            std::swap(obj, slots[i].obj);
+            std::swap(h, slots[i].hash);
+        }
+        i = (i + 1) & mask;
+        d++;
+    }
+    dists[i] = d;
+    new (&(slots[i].key)) Tkey(std::move(key));
+    slots[i].obj = obj;
+    slots[i].hash = h;
+};
+
+//backward shift deletion, every following entry that isn't in its home slot moves back one, so no tombstones are needed
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_RobinHoodHashTable<Tobj, Tkey, Thash> :: clearSlot(int i){
+    int mask = capacity - 1;
+    int next = (i + 1) & mask;
+    while (dists[next] > 1){
+        slots[i].key = std::move(slots[next].key);
+        slots[i].obj = slots[next].obj;
+        slots[i].hash = slots[next].hash;
+        dists[i] = dists[next] - 1;
+        i = next;
+        next = (next + 1) & mask;
+    }
+    slots[i].key.~Tkey();
+    dists[i] = 0;
+    keyCount--;
+};
+
+//moves every entry into a new slot array
+template <typename Tobj, typename Tkey, typename Thash>
+void mja_RobinHoodHashTable<Tobj, Tkey, Thash> :: rehash(int newCapacity){
+    unsigned int* oldDists = dists;
+    Slot* oldSlots = slots;
+    int oldCapacity = capacity;
+    allocate(newCapacity);
+    for (int i=0; i<oldCapacity; i++){
+        if (oldDists[i] != 0){
+            insert(std::move(oldSlots[i].key), oldSlots[i].obj, oldSlots[i].hash);
+            oldSlots[i].key.~Tkey();
+        }
+    }
+    delete[] oldDists;
+    ::operator delete(oldSlots);
+};
+
+//returns all the stored keys
+template <typename Tobj, typename Tkey, typename Thash>
+Tkey* mja_RobinHoodHashTable<Tobj, Tkey, Thash> :: getKeys(){
+    if (keyCount == 0){
+        return nullptr; //no keys stored to return
+    }
+    Tkey* output = new Tkey[keyCount];
+    int kCount = 0;
+    for (int i=0; i<capacity && kCount<keyCount; i++){
+        if (dists[i] != 0){
+            output[kCount++] = slots[i].key;
+        }
+    }
+    return output;
+};
+
+//longest probe length of any stored key
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_RobinHoodHashTable<Tobj, Tkey, Thash> :: getMaxProbeLength(){
+    int output = 0;
+    for (int i=0; i<capacity; i++){
+        if ((int)dists[i] > output){
+            output = dists[i];
+        }
+    }
+    return output;
+};
+
+//add given a new entry into the table, if an item is already bound to said key then the item is overwritten
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_RobinHoodHashTable<Tobj, Tkey, Thash> :: add(Tobj* obj, Tkey key){
+    unsigned int h = hashFunc(key);
+    int i = findSlot(key, h);
+    if (i >= 0){ //item is already bound to that key, replace it destructively
+        if (slots[i].obj != nullptr){
+            delete slots[i].obj;
+        }
+        slots[i].obj = obj;
+        return KEY_OVERWRITTEN;
+    }
+    if (keyCount + 1 > (int)(capacity * maxLoad)){
+        rehash(capacity * 2);
+    }
+    insert(key, obj, h);
+    keyCount++;
+    return SUCCESS;
+};
+
+//remove and deallocate an object if stored inside of the table
+template <typename Tobj, typename Tkey, typename Thash>
+int mja_RobinHoodHashTable<Tobj, Tkey, Thash> :: rem(Tkey key){
+    int i = findSlot(key, hashFunc(key));
+    if (i >= 0){
+        if (slots[i].obj != nullptr){
+            delete slots[i].obj;
+        }
+        clearSlot(i);
+        return SUCCESS; //indicate that item was removed successfully
+    }
+    return NON_EXIST_KEY; //indicate that item wasn't found
+};
+
+//remove an object from the table and return a pointer to it
+template <typename Tobj, typename Tkey, typename Thash>
+Tobj* mja_RobinHoodHashTable<Tobj, Tkey, Thash> :: pop(Tkey key){
+    int i = findSlot(key, hashFunc(key));
+    if (i >= 0){
+        Tobj* output = slots[i].obj;
+        clearSlot(i);
+        return output;
+    }
+    return nullptr; //not found return nullptr
+};
+
+
+#endif
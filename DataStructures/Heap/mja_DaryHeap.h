@@ -0,0 +1,188 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_DARYHEAP_H
+#define MJA_DARYHEAP_H
+
+//indexed d-ary min heap over the items 0 to capacity-1, each item is in the heap at most once so its priority can be decreased in place
+//a node's D children are next to each other in memory and each slot holds its priority, so finding the smallest child reads one or two cache lines
+//D = 4 halves the height of a binary heap while keeping the child scan short
+template <typename Tprio, int D = 4>
+class mja_DaryHeap {
+
+private:
+
+    struct Slot {
+        Tprio prio;
+        int item;
+    };
+
+    Slot* heap;
+    int* pos; //pos[item] is the item's index in heap, -1 if it isn't in the heap
+    int size = 0;
+    int capacity;
+
+    void siftUp(int i);
+    void siftDown(int i);
+
+public:
+
+    mja_DaryHeap(int capacity);
+    mja_DaryHeap(mja_DaryHeap<Tprio, D> &oldHeap); //copy constructor
+
+    ~mja_DaryHeap(){
+        delete[] heap;
+        delete[] pos;
+    };
+
+    bool isEmpty(){return (size == 0);};
+    int getSize(){return size;};
+    int getCapacity(){return capacity;};
+    bool contains(int item){return (pos[item] >= 0);};
+    Tprio getPriority(int item){return heap[pos[item]].prio;}; //item must be in the heap
+
+    int getTop(){return heap[0].item;}; //item with the smallest priority, heap must not be empty
+    Tprio getTopPriority(){return heap[0].prio;};
+
+    void push(int item, Tprio prio){heap[size].prio = prio; heap[size].item = item; pos[item] = size; size++; siftUp(size-1);}; //item must not already be in the heap
+    void decreaseKey(int item, Tprio prio){heap[pos[item]].prio = prio; siftUp(pos[item]);}; //prio must not be larger than the item's current priority
+    bool pushOrDecrease(int item, Tprio prio); //pushes the item, or lowers its priority if it's already in the heap with a larger one, returns whether anything changed
+    int pop(); //removes and returns the item with the smallest priority
+    void clear(); //empties the heap, only touches the items still in it
+};
+
+/*
+more lengthy/looping functions are defined below to prevent above main header getting spammed
+*/
+
+//base constructor
+template <typename Tprio, int D>
+mja_DaryHeap<Tprio, D> :: mja_DaryHeap(int capacity){
+    this->capacity = capacity;
+    heap = new Slot[capacity];
+    pos = new int[capacity];
+    for (int i=0; i<capacity; i++){
+        pos[i] = -1;
+    }
+};
+
+//copy constructor
+template <typename Tprio, int D>
+mja_DaryHeap<Tprio, D> :: mja_DaryHeap(mja_DaryHeap<Tprio, D> &oldHeap){
+    capacity = oldHeap.capacity;
+    size = oldHeap.size;
+    heap = new Slot[capacity];
+    pos = new int[capacity];
+    for (int i=0; i<size; i++){
+        heap[i] = oldHeap.heap[i];
+    }
+    for (int i=0; i<capacity; i++){
+        pos[i] = oldHeap.pos[i];
+    }
+};
+
+//moves a slot up until its parent is no larger, holes are shifted down rather than swapping at every level
+template <typename Tprio, int D>
+void mja_DaryHeap<Tprio, D> :: siftUp(int i){
+    Slot moving = heap[i];
+    while (i > 0){
+        int parent = (i - 1) / D;
+        if (!(moving.prio < heap[parent].prio)){
+            break;
+        }
+        heap[i] = heap[parent];
+        pos[heap[i].item] = i;
+        i = parent;
+    }
+    heap[i] = moving;
+    pos[moving.item] = i;
+};
+
+//moves a slot down until none of its children are smaller
+template <typename Tprio, int D>
+void mja_DaryHeap<Tprio, D> :: siftDown(int i){
+    Slot moving = heap[i];
+    while (true){
+        int first = i * D + 1;
+        if (first >= size){
+            break;
+        }
+        int last = (first + D < size) ? first + D : size;
+        int smallest = first;
+        for (int c=first+1; c<last; c++){
+            if (heap[c].prio < heap[smallest].prio){
+                smallest = c;
+            }
+        }
+        if (!(heap[smallest].prio < moving.prio)){
+            break;
+        }
+        heap[i] = heap[smallest];
+        pos[heap[i].item] = i;
+        i = smallest;
+    }
+    heap[i] = moving;
+    pos[moving.item] = i;
+};
+
+//pushes a new item or decreases an existing one's priority
+template <typename Tprio, int D>
+bool mja_DaryHeap<Tprio, D> :: pushOrDecrease(int item, Tprio prio){
+    if (pos[item] < 0){
+        push(item, prio);
+        return true;
+    }
+    if (prio < heap[pos[item]].prio){
+        decreaseKey(item, prio);
+        return true;
+    }
+    return false; //already in the heap with a priority that's no larger
+};
+
+//removes the smallest item, the last slot fills the hole at the top and sinks back down
+template <typename Tprio, int D>
+int mja_DaryHeap<Tprio, D> :: pop(){
+    int output = heap[0].item;
+    pos[output] = -1;
+    size--;
+    if (size > 0){
+        heap[0] = heap[size];
+        siftDown(0);
+    }
+    return output;
+};
+
+//empties the heap
+template <typename Tprio, int D>
+void mja_DaryHeap<Tprio, D> :: clear(){
+    for (int i=0; i<size; i++){
+        pos[heap[i].item] = -1;
+    }
+    size = 0;
+};
+
+
+#endif
@@ -0,0 +1,176 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_RADIXHEAP_H
+#define MJA_RADIXHEAP_H
+
+//monotone radix heap, a min heap for integer keys where every pushed key is at least the last popped key (as in Dijkstra with integer weights)
+//keys go into 65 buckets by the highest bit they differ from the last popped key in, so each key moves bucket at most 64 times
+//and push is O(1), pop is amortised O(log(max key)) with no comparisons between far apart keys
+//there's no decrease key, push the item again with its lower key and skip the stale copy when it's popped
+template <typename Titem>
+class mja_RadixHeap {
+
+private:
+
+    struct Slot {
+        unsigned long long key;
+        Titem item;
+    };
+
+    //growable array of slots
+    struct Bucket {
+        Slot* data = nullptr;
+        int size = 0;
+        int capacity = 0;
+    };
+
+    static const int BUCKET_COUNT = 65;
+    Bucket buckets[BUCKET_COUNT]; //bucket 0 holds keys equal to last, bucket i holds keys whose highest bit differing from last is bit i-1
+    unsigned long long last = 0; //last popped key, every stored key is at least this
+    int size = 0;
+
+    //bucket that a key belongs in relative to last
+    int getBucketIndex(unsigned long long key){
+        unsigned long long diff = key ^ last;
+        int output = 0;
+        while (diff != 0){ //position of the highest set bit + 1
+            diff >>= 1;
+            output++;
+        }
+        return output;
+    };
+
+    void append(int b, unsigned long long key, Titem item);
+    void refill(); //moves the smallest keys into bucket 0
+
+public:
+
+    mja_RadixHeap(){};
+    mja_RadixHeap(mja_RadixHeap<Titem> &oldHeap); //copy constructor
+
+    ~mja_RadixHeap(){
+        for (int b=0; b<BUCKET_COUNT; b++){
+            delete[] buckets[b].data;
+        }
+    };
+
+    bool isEmpty(){return (size == 0);};
+    int getSize(){return size;};
+
+    void push(unsigned long long key, Titem item){append(getBucketIndex(key), key, item); size++;}; //key must be at least the last popped key
+    unsigned long long getTopKey(){refill(); return buckets[0].data[buckets[0].size - 1].key;}; //heap must not be empty
+    Titem getTop(){refill(); return buckets[0].data[buckets[0].size - 1].item;};
+    Titem pop(); //removes and returns an item with the smallest key, heap must not be empty
+    void clear(); //empties the heap, and allows keys below the last popped key again
+};
+
+/*
+more lengthy/looping functions are defined below to prevent above main header getting spammed
+*/
+
+//copy constructor
+template <typename Titem>
+mja_RadixHeap<Titem> :: mja_RadixHeap(mja_RadixHeap<Titem> &oldHeap){
+    last = oldHeap.last;
+    size = oldHeap.size;
+    for (int b=0; b<BUCKET_COUNT; b++){
+        buckets[b].size = oldHeap.buckets[b].size;
+        buckets[b].capacity = oldHeap.buckets[b].size;
+        if (buckets[b].size > 0){
+            buckets[b].data = new Slot[buckets[b].size];
+            for (int i=0; i<buckets[b].size; i++){
+                buckets[b].data[i] = oldHeap.buckets[b].data[i];
+            }
+        }
+    }
+};
+
+//adds a slot to the end of a bucket, doubling its capacity if full
+template <typename Titem>
+void mja_RadixHeap<Titem> :: append(int b, unsigned long long key, Titem item){
+    Bucket& bucket = buckets[b];
+    if (bucket.size == bucket.capacity){
+        int newCapacity = (bucket.capacity == 0) ? 16 : bucket.capacity * 2;
+        Slot* newData = new Slot[newCapacity];
+        for (int i=0; i<bucket.size; i++){
+            newData[i] = bucket.data[i];
+        }
+        delete[] bucket.data;
+        bucket.data = newData;
+        bucket.capacity = newCapacity;
+    }
+    bucket.data[bucket.size].key = key;
+    bucket.data[bucket.size].item = item;
+    bucket.size++;
+};
+
+//if bucket 0 is empty, the first non-empty bucket's minimum becomes last and that bucket is spread over the lower buckets
+//every key in it shares last's bits above the bucket's bit, so they all land in strictly lower buckets
+template <typename Titem>
+void mja_RadixHeap<Titem> :: refill(){
+    if (buckets[0].size > 0){
+        return;
+    }
+    int b = 1;
+    while (buckets[b].size == 0){
+        b++;
+    }
+    Bucket& bucket = buckets[b];
+    unsigned long long newLast = bucket.data[0].key;
+    for (int i=1; i<bucket.size; i++){
+        if (bucket.data[i].key < newLast){
+            newLast = bucket.data[i].key;
+        }
+    }
+    last = newLast;
+    int count = bucket.size;
+    bucket.size = 0; //entries are read before being appended elsewhere, and never go back into this bucket
+    for (int i=0; i<count; i++){
+        append(getBucketIndex(bucket.data[i].key), bucket.data[i].key, bucket.data[i].item);
+    }
+};
+
+//pops from the end of bucket 0, every key there is equal to last
+template <typename Titem>
+Titem mja_RadixHeap<Titem> :: pop(){
+    refill();
+    size--;
+    return buckets[0].data[--buckets[0].size].item; //pre decrement access
+};
+
+//empties the heap, keeping the bucket memory for reuse
+template <typename Titem>
+void mja_RadixHeap<Titem> :: clear(){
+    for (int b=0; b<BUCKET_COUNT; b++){
+        buckets[b].size = 0;
+    }
+    last = 0;
+    size = 0;
+};
+
+
+#endif
@@ -28,6 +28,8 @@ SOFTWARE.
 #define MJA_LINKEDLIST_H
 
 #include "mja_LinkedListNode.h"
+#include <thread> //needed for the parallel cycle functions
+#include <atomic>
 
 //linked list data structure -- based vaguely off the one I used in my Mars Volcano Dash game
 template <typename T>
@@ -50,6 +52,10 @@ public:
     T* getAt(int i) {return getAt(i, false);};
     T* getLast(){return getAt(nodeCount);};
 
+    //returns the end nodes, used to mark ranges for splicing
+    mja_NodeLL<T>* getFirstNode(){return first;};
+    mja_NodeLL<T>* getLastNode(){return last;};
+
     //stores new objects
     void addFront(T* obj){add(obj, 0);};
     bool addAt(T* obj, int i){return add(obj, i);};
@@ -67,6 +73,17 @@ public:
     T* popNode(mja_NodeLL<T>* node) {return pop(node);};
     T* popEnd(){return pop(last);};
 
+    //moves nodes out of another list into this one in O(1), no nodes are reallocated and no objects are copied
+    void spliceFront(mja_LinkedList<T> &other){if (&other != this){splice(first, other, other.first, other.last, other.nodeCount);}};
+    void spliceEnd(mja_LinkedList<T> &other){if (&other != this){splice(nullptr, other, other.first, other.last, other.nodeCount);}};
+    //moves the node range [from, to] out of other and inserts it before pos (nullptr inserts at the end), count of -1 walks the range to count it
+    //other can be this list as long as pos isn't inside of the range
+    void splice(mja_NodeLL<T>* pos, mja_LinkedList<T> &other, mja_NodeLL<T>* from, mja_NodeLL<T>* to, int count);
+
+    //stable bottom-up merge sort that relinks the nodes in place, sorting operation takes form (left most item, right most item) like the array sorts
+    void mergeSort(bool(*sortOp)(T*, T*)){nodeMergeSort(sortOp);};
+    void mergeSort(bool(*sortOp)(T, T)){nodeMergeSort(sortOp);}; //compares copies, so prefer the pointer version for large objects
+
     //apply function to all items in an upward cycle
     template <typename Tret> void cycleUpFunc(Tret(*func)(T*)){cycleFunc(first, func);};
     template <typename Tret, typename Tpara> void cycleUpFunc(Tret(*func)(T*, Tpara*), Tpara* para){cycleFunc(first, func, para);};
@@ -77,6 +94,16 @@ public:
     template <typename Tret, typename Tpara> void cycleDownFunc(Tret(*func)(T*, Tpara*), Tpara* para){cycleFunc(last, func, para);};
     template <typename Tret, typename Tpara> void cycleDownFunc(Tret(*func)(T*, Tpara), Tpara para){cycleFunc(last, func, para);};
 
+    //apply function to all items in parallel, order of application is not guaranteed so func must be safe to run on separate items at the same time
+    //threadCount of 0 uses all hardware threads, grainSize is how many items a thread takes at a time (0 lets the list pick)
+    template <typename Tret> void parallelCycleFunc(Tret(*func)(T*)){parallelCycleFunc(func, 0, 0);};
+    template <typename Tret> void parallelCycleFunc(Tret(*func)(T*), int threadCount, int grainSize);
+    template <typename Tret, typename Tpara> void parallelCycleFunc(Tret(*func)(T*, Tpara*), Tpara* para, int threadCount, int grainSize);
+    template <typename Tret, typename Tpara> void parallelCycleFunc(Tret(*func)(T*, Tpara), Tpara para, int threadCount, int grainSize);
+    //parallel cycle with a reduction, reduce must be associative and commutative as items are combined in no set order
+    template <typename Tret> Tret parallelCycleFunc(Tret(*func)(T*), Tret(*reduce)(Tret, Tret), Tret identity){return parallelCycleFunc(func, reduce, identity, 0, 0);};
+    template <typename Tret> Tret parallelCycleFunc(Tret(*func)(T*), Tret(*reduce)(Tret, Tret), Tret identity, int threadCount, int grainSize);
+
     //manual access cycle system, greater manual control use at your own risk!
     mja_NodeLL<T>* cycle = nullptr;
     bool resetCycleUp(){cycle = first; return (cycle != nullptr);};
@@ -104,6 +131,15 @@ private:
     template <typename Tret, typename Tpara> void cycleFunc(mja_NodeLL<T>* start, Tret(*func)(T*, Tpara), Tpara para); //single parameter
     template <typename Tret, typename Tpara> void cycleFunc(mja_NodeLL<T>* start, Tret(*func)(T*, Tpara*), Tpara* para); //multiple parameters
 
+    //merge sort over the nodes, works for both pointer and value sorting operations
+    template <typename Tpara> void nodeMergeSort(bool(*sortOp)(Tpara, Tpara));
+    static bool sortCompare(bool(*sortOp)(T*, T*), T* a, T* b){return sortOp(a, b);};
+    static bool sortCompare(bool(*sortOp)(T, T), T* a, T* b){return sortOp(*a, *b);};
+
+    //snapshots the stored objects then shares them out between threads in chunks of grainSize, call takes the form (thread index, object)
+    template <typename Tcall> void parallelApply(Tcall &call, int threadCount, int grainSize);
+    int parallelThreadCount(int threadCount); //works out how many threads a parallel cycle should use
+
     mja_NodeLL<T>* first = nullptr;
     mja_NodeLL<T>* last = nullptr;
     int nodeCount = 0;
@@ -234,6 +270,97 @@ mja_NodeLL<T>* mja_LinkedList<T> :: getNode(int i, bool safe){
     return ptr;
 }
 
+//moves the node range [from, to] out of other and inserts it before pos
+template <typename T>
+void mja_LinkedList<T> :: splice(mja_NodeLL<T>* pos, mja_LinkedList<T> &other, mja_NodeLL<T>* from, mja_NodeLL<T>* to, int count){
+    if (from == nullptr || to == nullptr){
+        return; //nothing to move
+    }
+    if (count < 0){ //range size unknown so count it
+        count = 1;
+        for (mja_NodeLL<T>* ptr = from; ptr != to; ptr = ptr->next){
+            count++;
+        }
+    }
+
+    //unlink the range from the other list
+    if (from->prev != nullptr){
+        from->prev->next = to->next;
+    } else {
+        other.first = to->next;
+    }
+    if (to->next != nullptr){
+        to->next->prev = from->prev;
+    } else {
+        other.last = from->prev;
+    }
+    other.nodeCount -= count;
+
+    //link the range in before pos
+    mja_NodeLL<T>* before = (pos == nullptr) ? last : pos->prev;
+    from->prev = before;
+    to->next = pos;
+    if (before != nullptr){
+        before->next = from;
+    } else {
+        first = from;
+    }
+    if (pos != nullptr){
+        pos->prev = to;
+    } else {
+        last = to;
+    }
+    nodeCount += count;
+}
+
+//bottom-up merge sort, merges runs of width 1, 2, 4... until a single run remains, only ever relinks nodes so no memory is allocated
+template <typename T>
+template <typename Tpara>
+void mja_LinkedList<T> :: nodeMergeSort(bool(*sortOp)(Tpara, Tpara)){
+    if (nodeCount < 2){
+        return; //already sorted
+    }
+    for (int width = 1; width < nodeCount; width *= 2){
+        mja_NodeLL<T>* left = first;
+        mja_NodeLL<T>* tail = nullptr; //end of the merged output so far
+        first = nullptr;
+        while (left != nullptr){
+            //step along to find the start of the right run
+            mja_NodeLL<T>* right = left;
+            int leftSize = 0;
+            while (leftSize < width && right != nullptr){
+                right = right->next;
+                leftSize++;
+            }
+            int rightSize = width;
+
+            //merge the two runs, taking from the left unless the sort operation triggers (keeps equal items in order)
+            while (leftSize > 0 || (rightSize > 0 && right != nullptr)){
+                mja_NodeLL<T>* next;
+                if (leftSize == 0 || (rightSize > 0 && right != nullptr && sortCompare(sortOp, left->obj, right->obj))){
+                    next = right;
+                    right = right->next;
+                    rightSize--;
+                } else {
+                    next = left;
+                    left = left->next;
+                    leftSize--;
+                }
+                next->prev = tail;
+                if (tail != nullptr){
+                    tail->next = next;
+                } else {
+                    first = next;
+                }
+                tail = next;
+            }
+            left = right; //next pair of runs starts where the right run stopped
+        }
+        tail->next = nullptr;
+        last = tail;
+    }
+}
+
 //cycle functions
 //apply a function with no extra parameters than the stored object
 template <typename T>
@@ -289,6 +416,113 @@ void mja_LinkedList<T> :: cycleFunc(mja_NodeLL<T>* start, Tret(*func)(T*, Tpara*
     }
 }
 
+//parallel cycle functions
+//works out how many threads to use, never more than there are items to work on
+template <typename T>
+int mja_LinkedList<T> :: parallelThreadCount(int threadCount){
+    if (threadCount <= 0){
+        threadCount = (int)std::thread::hardware_concurrency();
+        if (threadCount <= 0){
+            threadCount = 1; //hardware thread count is unknown so run on the calling thread only
+        }
+    }
+    if (threadCount > nodeCount){
+        threadCount = nodeCount;
+    }
+    return threadCount;
+}
+
+//shared parallel engine, a single pass snapshots the objects so threads can then jump straight to their chunk
+template <typename T>
+template <typename Tcall>
+void mja_LinkedList<T> :: parallelApply(Tcall &call, int threadCount, int grainSize){
+    if (nodeCount == 0){
+        return;
+    }
+    T** objs = new T*[nodeCount];
+    T** shift = objs;
+    for (mja_NodeLL<T>* ptr = first; ptr != nullptr; ptr = ptr->next){
+        *(shift++) = ptr->obj; //post increment access
+    }
+
+    if (grainSize <= 0){
+        grainSize = nodeCount / (threadCount * 8); //several chunks per thread so uneven work still balances out
+        if (grainSize <= 0){
+            grainSize = 1;
+        }
+    }
+
+    //threads grab the next unclaimed chunk until all chunks are gone
+    std::atomic<int> nextChunk(0);
+    int count = nodeCount;
+    auto worker = [&](int t){
+        int start;
+        while ((start = nextChunk.fetch_add(grainSize)) < count){
+            int end = (count - start < grainSize) ? count : start + grainSize;
+            for (int i=start; i<end; i++){
+                call(t, objs[i]);
+            }
+        }
+    };
+
+    std::thread* threads = new std::thread[threadCount-1]; //calling thread acts as thread 0
+    for (int t=1; t<threadCount; t++){
+        threads[t-1] = std::thread(worker, t);
+    }
+    worker(0);
+    for (int t=1; t<threadCount; t++){
+        threads[t-1].join();
+    }
+    delete[] threads;
+    delete[] objs;
+}
+
+//apply a function with no extra parameters in parallel
+template <typename T>
+template <typename Tret>
+void mja_LinkedList<T> :: parallelCycleFunc(Tret(*func)(T*), int threadCount, int grainSize){
+    auto call = [func](int, T* obj){func(obj);};
+    parallelApply(call, parallelThreadCount(threadCount), grainSize);
+}
+
+//apply a function with multiple parameters in parallel, para is shared between all threads
+template <typename T>
+template <typename Tret, typename Tpara>
+void mja_LinkedList<T> :: parallelCycleFunc(Tret(*func)(T*, Tpara*), Tpara* para, int threadCount, int grainSize){
+    auto call = [func, para](int, T* obj){func(obj, para);};
+    parallelApply(call, parallelThreadCount(threadCount), grainSize);
+}
+
+//apply a function with a single parameter in parallel
+template <typename T>
+template <typename Tret, typename Tpara>
+void mja_LinkedList<T> :: parallelCycleFunc(Tret(*func)(T*, Tpara), Tpara para, int threadCount, int grainSize){
+    auto call = [func, &para](int, T* obj){func(obj, para);};
+    parallelApply(call, parallelThreadCount(threadCount), grainSize);
+}
+
+//apply a function in parallel and combine the results, each thread reduces into its own total which are then combined at the end
+template <typename T>
+template <typename Tret>
+Tret mja_LinkedList<T> :: parallelCycleFunc(Tret(*func)(T*), Tret(*reduce)(Tret, Tret), Tret identity, int threadCount, int grainSize){
+    threadCount = parallelThreadCount(threadCount);
+    if (threadCount == 0){
+        return identity; //empty list
+    }
+    Tret* totals = new Tret[threadCount];
+    for (int t=0; t<threadCount; t++){
+        totals[t] = identity;
+    }
+    auto call = [func, reduce, totals](int t, T* obj){totals[t] = reduce(totals[t], func(obj));};
+    parallelApply(call, threadCount, grainSize);
+    Tret output = identity;
+    for (int t=0; t<threadCount; t++){
+        output = reduce(output, totals[t]);
+    }
+    delete[] totals;
+    return output;
+}
+
 
 
 #endif
@@ -29,16 +29,23 @@ SOFTWARE.
 
 template <typename T>
 class mja_LinkedList; //so NodeLL<T> can access it
+template <typename Tobj, typename Tkey, typename Thash>
+class mja_FlatHashTable; //so nodes can be indexed by a safe destruction flat hash table (e.g. the graph's per vertex edge index)
 
 //node that stores objects inside of the linked list
 template <typename T>
 class mja_NodeLL {
 
 friend class mja_LinkedList<T>;
+template <typename Tobj, typename Tkey, typename Thash> friend class mja_FlatHashTable;
 
 public:
     T* obj; //public so stored object can be easily accessed and used
 
+    //neighbouring nodes, read only so the list structure can't be broken externally
+    mja_NodeLL* getPrev(){return prev;};
+    mja_NodeLL* getNext(){return next;};
+
 private:
 
     //constructor used for empty lists
@@ -0,0 +1,231 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 Matthew James Austin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MJA_UNIONFIND_H
+#define MJA_UNIONFIND_H
+
+#include <atomic> //needed for the concurrent variant
+
+//disjoint sets over the items 0 to size-1, every item starts in a set of its own
+//finds compress the path they walk and unions hang the shallower tree under the deeper one, so operations are effectively O(1)
+class mja_UnionFind {
+
+private:
+
+    int* parents; //parents[i] == i for the root of a set
+    unsigned char* ranks; //upper bound on each root's tree height, never passes log2(size)
+    int size;
+    int setCount;
+
+public:
+
+    mja_UnionFind(int size);
+    mja_UnionFind(mja_UnionFind &oldSets); //copy constructor
+
+    ~mja_UnionFind(){
+        delete[] parents;
+        delete[] ranks;
+    };
+
+    int getSize(){return size;};
+    int getSetCount(){return setCount;};
+
+    int find(int item); //returns the root of item's set
+    bool unite(int a, int b); //merges the sets of a and b, returns false if they were already the same set
+    bool isSame(int a, int b){return (find(a) == find(b));};
+    void clear(); //puts every item back in a set of its own
+};
+
+//lock free disjoint sets that any number of threads can unite and find on at once
+//unions always hang the larger root under the smaller one with a compare and swap, so the root of a set is always its smallest item
+//(the fixed order stands in for rank, which can't be updated together with the parent without a lock)
+//finds halve the path they walk, pointing items at their grandparents, which is safe alongside other threads' links
+class mja_ConcurrentUnionFind {
+
+private:
+
+    std::atomic<int>* parents;
+    int size;
+
+public:
+
+    mja_ConcurrentUnionFind(int size);
+    mja_ConcurrentUnionFind(mja_ConcurrentUnionFind &oldSets) = delete; //only copyable while no thread is using it, so don't allow it
+
+    ~mja_ConcurrentUnionFind(){delete[] parents;};
+
+    int getSize(){return size;};
+    int getSetCount(); //only exact while no other thread is uniting
+
+    int find(int item); //returns the root of item's set, the smallest item in it once every union has finished
+    bool unite(int a, int b); //merges the sets of a and b, returns false if they were already the same set
+    bool isSame(int a, int b); //only exact while no other thread is uniting
+    void clear(); //puts every item back in a set of its own, not thread safe
+};
+
+/*
+more lengthy/looping functions are defined below to prevent above main header getting spammed
+*/
+
+//base constructor
+inline mja_UnionFind :: mja_UnionFind(int size){
+    this->size = (size > 0) ? size : 0;
+    parents = new int[this->size];
+    ranks = new unsigned char[this->size];
+    clear();
+};
+
+//copy constructor
+inline mja_UnionFind :: mja_UnionFind(mja_UnionFind &oldSets){
+    size = oldSets.size;
+    setCount = oldSets.setCount;
+    parents = new int[size];
+    ranks = new unsigned char[size];
+    for (int i=0; i<size; i++){
+        parents[i] = oldSets.parents[i];
+        ranks[i] = oldSets.ranks[i];
+    }
+};
+
+//every item becomes its own root
+inline void mja_UnionFind :: clear(){
+    for (int i=0; i<size; i++){
+        parents[i] = i;
+        ranks[i] = 0;
+    }
+    setCount = size;
+};
+
+//walks up to the root, then points everything on the way straight at it
+inline int mja_UnionFind :: find(int item){
+    int root = item;
+    while (parents[root] != root){
+        root = parents[root];
+    }
+    while (parents[item] != root){
+        int next = parents[item];
+        parents[item] = root;
+        item = next;
+    }
+    return root;
+};
+
+//union by rank, the lower ranked root goes under the higher ranked one
+inline bool mja_UnionFind :: unite(int a, int b){
+    a = find(a);
+    b = find(b);
+    if (a == b){
+        return false; //already in the same set
+    }
+    if (ranks[a] < ranks[b]){
+        int temp = a;
+        a = b;
+        b = temp;
+    }
+    parents[b] = a;
+    if (ranks[a] == ranks[b]){
+        ranks[a]++;
+    }
+    setCount--;
+    return true;
+};
+
+//base constructor
+inline mja_ConcurrentUnionFind :: mja_ConcurrentUnionFind(int size){
+    this->size = (size > 0) ? size : 0;
+    parents = new std::atomic<int>[this->size];
+    clear();
+};
+
+//every item becomes its own root
+inline void mja_ConcurrentUnionFind :: clear(){
+    for (int i=0; i<size; i++){
+        parents[i].store(i, std::memory_order_relaxed);
+    }
+};
+
+//counts the roots
+inline int mja_ConcurrentUnionFind :: getSetCount(){
+    int output = 0;
+    for (int i=0; i<size; i++){
+        if (parents[i].load(std::memory_order_relaxed) == i){
+            output++;
+        }
+    }
+    return output;
+};
+
+//path halving, a failed compare and swap just means another thread already moved the item closer to the root
+inline int mja_ConcurrentUnionFind :: find(int item){
+    while (true){
+        int parent = parents[item].load(std::memory_order_acquire);
+        if (parent == item){
+            return item;
+        }
+        int grandparent = parents[parent].load(std::memory_order_acquire);
+        if (grandparent != parent){
+            parents[item].compare_exchange_weak(parent, grandparent, std::memory_order_release, std::memory_order_relaxed);
+        }
+        item = grandparent;
+    }
+};
+
+//links the larger root under the smaller, retrying if another thread linked either root first
+inline bool mja_ConcurrentUnionFind :: unite(int a, int b){
+    while (true){
+        a = find(a);
+        b = find(b);
+        if (a == b){
+            return false; //already in the same set
+        }
+        if (a < b){
+            int temp = a;
+            a = b;
+            b = temp;
+        }
+        int expected = a;
+        if (parents[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel, std::memory_order_acquire)){
+            return true;
+        }
+    }
+};
+
+//roots can move while checking, so retry until a's root is seen to still be a root
+inline bool mja_ConcurrentUnionFind :: isSame(int a, int b){
+    while (true){
+        a = find(a);
+        b = find(b);
+        if (a == b){
+            return true;
+        }
+        if (parents[a].load(std::memory_order_acquire) == a){
+            return false;
+        }
+    }
+};
+
+
+#endif